@@ -1,13 +1,27 @@
 #pragma once
 #include "BFSVisualizer.h"
+#include "ConnectedComponents.h"
+#include "ForceLayout.h"
 #include "Graph.h"
+#include "GraphReorder.h"
+#include "LodRenderer.h"
+#include "SpatialIndex.h"
 #include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <future>
 #include <memory>
+#include <string>
 
 class Application {
 public:
-  Application();
-  ~Application() = default;
+  // Restores `snapshotPath` if one is given and the file exists, else loads
+  // `graphPath` if given, otherwise starts with a generated graph. F5/F9
+  // save to and restore from `snapshotPath` (GRAPH_CONFIG::SNAPSHOT_PATH if
+  // empty).
+  explicit Application(std::uint64_t seed, std::string graphPath = "",
+                       std::string snapshotPath = "");
+  ~Application();
 
   void run();
 
@@ -20,17 +34,87 @@ private:
   // Application objects
   std::unique_ptr<Graph> m_graph;
   std::unique_ptr<BFSVisualizer> m_visualizer;
+  std::unique_ptr<ForceLayout> m_layout;
+
+  // Background graph generation. Each G press uses the next stream of
+  // m_seed, so a session can be replayed with --seed.
+  std::uint64_t m_seed;
+  std::uint64_t m_nextStream = 0;
+  std::future<std::unique_ptr<Graph>> m_pendingGraph;
+  std::shared_ptr<GenerationProgress> m_generationProgress;
+
+  // Session snapshots: F5 copies the graph and traversal state into a
+  // SnapshotWriter and writes it on a worker; F9 maps the file back in
+  std::string m_snapshotPath;
+  std::future<bool> m_pendingSnapshot;
+  std::chrono::steady_clock::time_point m_snapshotStart;
+  std::size_t m_snapshotBytes = 0;
+  void saveSnapshot();
+  bool restoreSnapshot();
+  void pollSnapshotWrite();
+
+  // Vertex reordering (cycled with O)
+  ReorderStrategy m_nextReorder = ReorderStrategy::REVERSE_CUTHILL_MCKEE;
+  void reorderGraph();
+
+  // Camera over the graph (wheel zoom, right-drag pan, 0 resets) and the
+  // grid used to cull primitives outside it; rebuilt when the graph changes.
+  // m_renderer picks the level of detail from the zoom.
+  sf::View m_camera;
+  bool m_panning = false;
+  sf::Vector2i m_panAnchor;
+  SpatialIndex m_spatialIndex;
+  bool m_spatialDirty = true;
+  LodRenderer m_renderer;
+  void zoomCamera(float delta, sf::Vector2i pixel);
+  void resetCamera();
+  void drawCameraInfo();
+
+  // Connected-component colouring (toggled with C), recomputed on a worker
+  // after edits and graph swaps while enabled; at most one job is in flight
+  bool m_showComponents = false;
+  bool m_componentsDirty = false;
+  std::unique_ptr<ConnectedComponents> m_components; // Last finished job
+  std::future<std::unique_ptr<ConnectedComponents>> m_pendingComponents;
+  void markGraphChanged(); // Invalidates components and the culling grid
+  void startComponents();
+  void pollComponents();
+  void clearComponentColors();
+  void drawComponentSummary();
+
+  // Graph editing (toggled with E): click two nodes to toggle an edge, click
+  // empty space to add a node, Delete removes the selected node
+  bool m_editMode = false;
+  int m_selectedNode = -1;
+  void handleEditClick(sf::Vector2f mousePos);
+  void selectNode(int nodeId);
+  void removeSelectedNode();
+  void drawEditHint();
+
+  // Damage tracking: the scene is redrawn only when this is set (input,
+  // visualizer changes, graph changes, animation); otherwise run() blocks in
+  // waitForWork until the next event or scheduled wake-up
+  bool m_needsRedraw = true;
+  void waitForWork();
 
   // Event handling
   void handleEvents();
+  void handleEvent(const sf::Event &event);
   void handleKeyPressed(sf::Keyboard::Key key);
   void handleMousePressed(sf::Vector2f mousePos);
 
   // Rendering
   void update(float deltaTime);
   void render();
+  void drawGenerationProgress();
 
   // Initialization
   bool loadResources();
-  void initializeGraph();
+  void initializeGraph(const std::string &graphPath, bool resumeSnapshot);
+
+  // Graph generation
+  bool isGenerating() const { return m_pendingGraph.valid(); }
+  void startGraphGeneration();
+  void cancelGraphGeneration();
+  void pollGraphGeneration();
 };
@@ -1,8 +1,13 @@
 #pragma once
+#include "CompressedAdjacency.h"
+#include "DynamicBFS.h"
 #include "Graph.h"
+#include "RingBuffer.h"
+#include "TraversalEngine.h"
+#include "TraversalStats.h"
 #include <SFML/Graphics.hpp>
-#include <queue>
-#include <unordered_set>
+#include <chrono>
+#include <cstdint>
 #include <vector>
 
 enum class BFSState { READY, RUNNING, PAUSED, FINISHED };
@@ -19,20 +24,75 @@ public:
   void resume();
   void reset();
 
+  // Algorithm for the next traversal; changing it resets the visualizer
+  void setAlgorithm(TraversalAlgorithm algorithm);
+  TraversalAlgorithm getAlgorithm() const { return m_algorithm; }
+
+  // Marks nodeId as the target of the next traversal (or clears it if it
+  // already was). Every engine stops once the target is settled.
+  void toggleTarget(int nodeId);
+
+  // Graph editing: call after the graph gained or lost edge (u, v). The
+  // distance tree is repaired incrementally and a running traversal
+  // continues on the edited adjacency.
+  void onEdgeToggled(int u, int v, bool added);
+
+  // Snapshot sections for the traversal: state, context arrays and queue or
+  // heap, visit order and stats. Restore after the graph has been restored;
+  // a running or paused traversal resumes at the step where it was saved.
+  // Returns false (and leaves the visualizer untouched) on inconsistent data.
+  void writeSnapshot(SnapshotWriter &writer) const;
+  bool restoreSnapshot(const SnapshotReader &reader);
+
+  // The check restoreSnapshot() makes, against the graph the traversal will
+  // run on, so a caller can validate both halves before committing either
+  static bool isValidSnapshot(const SnapshotReader &reader,
+                              const Graph &graph);
+
   // Getters
   BFSState getState() const { return m_state; }
-  const std::queue<int> &getQueue() const { return m_queue; }
+  const RingBuffer<int> &getQueue() const { return m_context.queue; }
   const std::vector<int> &getVisitOrder() const { return m_visitOrder; }
   int getCurrentNode() const { return m_currentNode; }
   bool isAutoStepping() const { return m_autoStep; }
+  const DynamicBFS &getDistances() const { return m_distances; }
+  const TraversalStats &getStats() const { return m_stats; }
 
   // Auto-stepping
-  void setAutoStep(bool enable) { m_autoStep = enable; }
+  void setAutoStep(bool enable) {
+    m_autoStep = enable;
+    m_changed = true;
+  }
   void setStepDelay(float delay) { m_stepDelay = delay; }
 
-  // Update (for auto-stepping)
+  // Seconds until update() will step on its own: 0 while turbo runs,
+  // infinity when nothing is scheduled
+  float getTimeToNextStep() const;
+
+  // True once after anything drawn by this class (or node states) changed,
+  // so the application can skip redrawing an unchanged scene
+  bool consumeChanges();
+
+  // Turbo: run as many steps as fit in ALGO_CONFIG::TURBO_FRAME_BUDGET_MS
+  // each frame instead of one step per m_stepDelay
+  void setTurbo(bool enable);
+  bool isTurbo() const { return m_turbo; }
+  float getStepsPerSecond() const { return m_stepsPerSecond; }
+
+  // Update (for auto-stepping); also applies the frame's node-state changes
   void update(float deltaTime);
 
+  // Queue display scrolling; the offset is the first queue index shown
+  void scrollQueue(long long delta);
+  void scrollQueueToFront() {
+    m_queueScroll = 0;
+    m_changed = true;
+  }
+  void scrollQueueToBack() {
+    m_queueScroll = m_context.queue.size();
+    m_changed = true;
+  }
+
   // Rendering
   void drawQueue(sf::RenderWindow &window, sf::Font &font) const;
   void drawInfo(sf::RenderWindow &window, sf::Font &font) const;
@@ -41,9 +101,22 @@ private:
   Graph &m_graph;
   BFSState m_state;
 
-  // BFS data structures
-  std::queue<int> m_queue;
-  std::unordered_set<int> m_visited;
+  // Compressed snapshot of m_graph taken when a traversal starts, weighted
+  // as m_algorithm requires, and the A* heuristic towards m_target, fixed at
+  // start against m_targetPosition (ids added later are filled in)
+  TraversalAlgorithm m_algorithm;
+  CompressedAdjacency m_adjacency;
+  std::vector<std::uint32_t> m_heuristic;
+  sf::Vector2f m_targetPosition;
+  int m_target;
+
+  // Distance levels from m_startNode, kept up to date across edits
+  DynamicBFS m_distances;
+
+  // BFS data structures: the engine coroutine owns the algorithm and
+  // writes levels, parents and the queue into m_context
+  Generator<TraversalEvent> m_engine;
+  TraversalContext m_context;
   std::vector<int> m_visitOrder;
   int m_currentNode;
   int m_startNode;
@@ -53,7 +126,45 @@ private:
   float m_stepDelay;
   float m_timeSinceLastStep;
 
+  // Turbo mode and achieved-rate measurement
+  bool m_turbo;
+  float m_stepsPerSecond;
+  float m_rateWindowTime;
+  int m_rateWindowSteps;
+
+  // Queue display
+  size_t m_queueScroll;
+
+  // Per-level metrics of the current traversal (per distance bucket for
+  // weighted engines, see getStatsBucket). Steps are timed in
+  // batches starting at m_batchStart, not one clock read per expansion.
+  TraversalStats m_stats;
+  std::chrono::steady_clock::time_point m_batchStart;
+
+  // Node-state changes made by step(), applied once per frame by update():
+  // a flat per-id array (NodeState, or NO_PENDING_STATE) sized when the
+  // traversal starts, plus the ids changed this frame in first-touch order
+  static constexpr std::int8_t NO_PENDING_STATE = -1;
+  std::vector<std::int8_t> m_pendingStates;
+  std::vector<int> m_pendingIds;
+
+  // Damage flag read by consumeChanges()
+  bool m_changed;
+
   // Helper methods
-  void updateNodeStates();
+  void advance(); // One untimed step
+  std::chrono::steady_clock::time_point closeBatch(); // Times the batch
+  void rebuildAdjacency();
+  void freezeHeuristic(); // Restarts m_heuristic from current positions
+  void extendHeuristic(); // Fills m_heuristic for ids it does not cover yet
+  int getStatsBucket(int nodeId) const; // TraversalStats key of a settled node
+  static std::uint32_t getStatsBucket(TraversalAlgorithm algorithm, int level,
+                                      std::uint32_t distance);
+  void runTurboSteps();
+  void finish();
+  void markNode(int nodeId, NodeState state);
+  void flushNodeStates();
   void resetNodeStates();
+  void drawHistogram(sf::RenderWindow &window, sf::Vector2f position,
+                     sf::Vector2f size) const;
 };
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct BatchOptions {
+  std::uint64_t seed = 0;
+  std::size_t count = 0;
+  std::string outputDir = "graphs";
+  unsigned int threads = 0; // 0 = one per hardware thread
+};
+
+// Headless generation of many seeded graphs for experiment sweeps. Graph k is
+// generated from (seed, k) on whichever worker claims it and written straight
+// to <outputDir>/graph_<k>.txt, so any single graph can be reproduced later
+// without regenerating the rest of the batch.
+class BatchGenerator {
+public:
+  explicit BatchGenerator(BatchOptions options);
+  ~BatchGenerator() = default;
+
+  // Returns false if the output directory or any graph file can't be written
+  bool run();
+
+private:
+  BatchOptions m_options;
+
+  std::string outputPath(std::size_t index) const;
+};
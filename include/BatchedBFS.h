@@ -0,0 +1,70 @@
+#pragma once
+#include "CompressedAdjacency.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// What a query asks about its source (and target)
+enum class QueryKind : std::uint8_t {
+  LEVELS = 1,    // Vertex count of every BFS level from the source
+  REACHABLE = 2, // Whether the target can be reached at all
+  DISTANCE = 3,  // Hop distance to the target, -1 if unreachable
+  PATH = 4,      // One shortest source..target vertex sequence
+};
+
+struct BfsQuery {
+  QueryKind kind = QueryKind::DISTANCE;
+  int source = 0;
+  int target = 0; // Ignored by LEVELS
+
+  // Results
+  int distance = -1;                  // -1: unreachable (LEVELS: eccentricity)
+  std::vector<std::uint32_t> levels;  // LEVELS only
+  std::vector<int> path;              // PATH only, source first
+};
+
+// Bit-parallel multi-source BFS. Every distinct source in a batch gets one
+// bit ("lane") of a 64-bit word, and each vertex keeps a seen and a frontier
+// word, so one level-synchronous sweep advances up to 64 traversals with a
+// single OR per edge. Queries sharing a source share its lane.
+//
+// Lanes stop being propagated once every query on them is answered, and the
+// sweep ends when no unanswered lane has a frontier left, so a batch of
+// short s-t queries only explores as far as its farthest target. PATH lanes
+// additionally record the first parent that reached each vertex, which costs
+// a vertex-sized array per lane; SERVER_CONFIG::MAX_PATH_LANES bounds them.
+class BatchedBFS {
+public:
+  static constexpr int LANES = 64;
+
+  explicit BatchedBFS(const CompressedAdjacency &adjacency);
+  ~BatchedBFS() = default;
+
+  // Answers the longest prefix of `queries` that fits in one batch (at most
+  // LANES distinct sources and MAX_PATH_LANES sources with PATH queries) and
+  // returns its length. Vertex ids must be valid; the caller checks them.
+  std::size_t run(std::span<BfsQuery> queries);
+
+  // Last batch
+  int getLaneCount() const { return m_laneCount; }
+  int getLevelCount() const { return m_levelCount; }
+
+private:
+  const CompressedAdjacency &m_adjacency;
+
+  // Per vertex lane masks; all zero between batches
+  std::vector<std::uint64_t> m_seen;
+  std::vector<std::uint64_t> m_frontier;
+  std::vector<std::uint64_t> m_next;
+
+  std::vector<int> m_frontierList; // Vertices with a non-zero frontier word
+  std::vector<int> m_nextList;     // Vertices with a non-zero next word
+  std::vector<int> m_visited;      // Every vertex seen this batch, for reset
+
+  // PATH lanes: parent of each vertex, valid where the lane's seen bit is set
+  std::vector<std::vector<int>> m_parents;
+
+  int m_laneCount = 0;
+  int m_levelCount = 0;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+struct ComponentsBenchmarkOptions {
+  int gridSide = 1000; // Labels a gridSide x gridSide percolated grid
+  int repeats = 5;
+  unsigned int threads = 0; // 0 = all cores
+};
+
+// Headless timing of ConnectedComponents on a bond-percolated grid (each
+// edge kept with probability 1/2, so there are many components of every
+// size). The labelling is checked against a sequential BFS.
+class ComponentsBenchmark {
+public:
+  explicit ComponentsBenchmark(ComponentsBenchmarkOptions options);
+  ~ComponentsBenchmark() = default;
+
+  // Returns false if the labellings disagree
+  bool run();
+
+private:
+  ComponentsBenchmarkOptions m_options;
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+class Graph;
+
+// Per-edge weights a snapshot can carry, derived from node positions
+enum class EdgeWeights : std::uint8_t {
+  NONE,     // Unweighted; traversals treat every edge as cost 1
+  LENGTH,   // ceil(Euclidean length)
+  ZERO_ONE, // 0 up to ALGO_CONFIG::FREE_EDGE_MAX_LENGTH, 1 beyond it
+};
+
+// Read-only adjacency in which each vertex's sorted neighbor list is stored
+// as a small header plus bit-packed gaps:
+//
+//   varint degree | u8 gap width | zigzag varint (first - vertex) | gaps
+//
+// Gaps are (next - previous - 1) packed at a per-vertex bit width, so a list
+// of consecutive ids costs zero bits per edge after the first, and reordered
+// graphs (see GraphReorder) compress far better than raw ids. Vertex ids are
+// assumed to be dense in [0, getVertexCount()); missing ids have no
+// neighbors. Optional edge weights are kept uncompressed next to the lists,
+// in the same (sorted) order as neighbors(v) yields them.
+class CompressedAdjacency {
+public:
+  using VertexId = int; // Satisfies TraversableGraph (GraphConcept.h)
+
+  // Forward iterator decoding one neighbor per increment
+  class NeighborIterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int *;
+    using reference = int;
+
+    NeighborIterator() = default;
+    NeighborIterator(const std::uint8_t *data, std::uint64_t bit,
+                     std::uint32_t width, std::uint32_t remaining, int first)
+        : m_data(data), m_bit(bit), m_width(width), m_remaining(remaining),
+          m_current(first) {}
+
+    int operator*() const { return m_current; }
+
+    NeighborIterator &operator++() {
+      if (--m_remaining > 0) {
+        m_current += 1 + static_cast<int>(readBits());
+      }
+      return *this;
+    }
+
+    NeighborIterator operator++(int) {
+      NeighborIterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    // Only the remaining count matters: end() has none left
+    bool operator==(const NeighborIterator &other) const {
+      return m_remaining == other.m_remaining;
+    }
+    bool operator!=(const NeighborIterator &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    const std::uint8_t *m_data = nullptr;
+    std::uint64_t m_bit = 0;
+    std::uint32_t m_width = 0;
+    std::uint32_t m_remaining = 0;
+    int m_current = 0;
+
+    // One unaligned 64-bit load per gap; the buffer carries 8 bytes of tail
+    // padding so this never reads past the end
+    std::uint64_t readBits() {
+      if (m_width == 0)
+        return 0;
+      std::uint64_t word;
+      std::memcpy(&word, m_data + (m_bit >> 3), sizeof(word));
+      std::uint64_t value =
+          (word >> (m_bit & 7)) & ((std::uint64_t{1} << m_width) - 1);
+      m_bit += m_width;
+      return value;
+    }
+  };
+
+  class NeighborRange {
+  public:
+    NeighborRange(NeighborIterator begin, std::uint32_t degree)
+        : m_begin(begin), m_degree(degree) {}
+    NeighborIterator begin() const { return m_begin; }
+    NeighborIterator end() const { return NeighborIterator(); }
+    std::uint32_t size() const { return m_degree; }
+    bool empty() const { return m_degree == 0; }
+
+  private:
+    NeighborIterator m_begin;
+    std::uint32_t m_degree;
+  };
+
+  CompressedAdjacency() = default;
+
+  // Snapshot of the graph's current adjacency
+  explicit CompressedAdjacency(const Graph &graph,
+                               EdgeWeights weights = EdgeWeights::NONE);
+
+  // Build from explicit neighbor lists (index = vertex id); each list is
+  // sorted and deduplicated during encoding
+  explicit CompressedAdjacency(std::vector<std::vector<int>> neighborLists);
+
+  // Re-encode one vertex from the graph's current list (and weights) after
+  // an edit, in O(degree): the new encoding is appended and the vertex
+  // repointed at it. Ids past the end extend the snapshot with empty lists.
+  // Outstanding neighbor iterators are invalidated.
+  void updateVertex(const Graph &graph, int vertex);
+
+  NeighborRange neighbors(int vertex) const;
+  std::uint32_t getDegree(int vertex) const;
+
+  // Weights of vertex's edges, parallel to neighbors(vertex); nullptr if
+  // the snapshot is unweighted
+  const std::uint32_t *weights(int vertex) const;
+  EdgeWeights getWeightKind() const { return m_weightKind; }
+
+  int getVertexCount() const { return static_cast<int>(m_offsets.size()); }
+  std::size_t getEdgeCount() const { return m_edgeCount; }
+
+  // Encoded size including the per-vertex offset index, and how much of it
+  // is superseded encodings left behind by updateVertex
+  std::size_t getByteSize() const;
+  std::size_t getDeadBytes() const { return m_deadBytes; }
+  double getBitsPerEdge() const;
+
+private:
+  std::vector<std::uint64_t> m_offsets; // Byte offset of each vertex
+  std::vector<std::uint8_t> m_data;
+  std::size_t m_edgeCount = 0;
+  std::size_t m_deadBytes = 0;
+  std::vector<std::uint64_t> m_gaps; // Encoding scratch
+
+  EdgeWeights m_weightKind = EdgeWeights::NONE;
+  std::vector<std::size_t> m_weightOffsets; // First weight of each vertex
+  std::vector<std::uint32_t> m_weights;
+
+  void encode(std::vector<std::vector<int>> &neighborLists);
+  void encodeList(int vertex, std::vector<int> &list); // Appends to m_data
+  void appendWeights(const Graph &graph, int vertex);
+  std::size_t getEncodedSize(int vertex) const;
+  static void appendVarint(std::vector<std::uint8_t> &out, std::uint64_t v);
+  static std::uint64_t readVarint(const std::uint8_t *&in);
+};
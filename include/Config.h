@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 
 class Config {
 public:
@@ -15,12 +16,17 @@ public:
     static constexpr unsigned int HEIGHT = 900;
     static constexpr float ASPECT_RATIO = static_cast<float>(WIDTH) / HEIGHT;
     static constexpr const char *TITLE = "BFS Visualizer";
+
+    // While idle the loop sleeps in waitEvent; background jobs (generation,
+    // heatmap rasters) are polled at this interval instead of every frame
+    static constexpr float BACKGROUND_POLL_SECONDS = 1.0f / 30.0f;
   };
 
   /* Node Configuration */
   struct Node {
     static constexpr float BASE_RADIUS = 40.0f;
     static constexpr float OUTLINE_THICKNESS = 3.0f;
+    static constexpr float SELECTED_OUTLINE_THICKNESS = 6.0f;
   };
 
   /* Graph Layout Configuration */
@@ -86,10 +92,84 @@ public:
       return MIN_NODE_DISTANCE * GRID_SPACING_MULTIPLIER;
     }
 
+    // Viewport culling grid (SpatialIndex); cells grow on sparse graphs
+    static constexpr float SPATIAL_CELL_SIZE = 256.0f;
+    static constexpr int MAX_EDGE_CELLS = 64; // Longer edges tested directly
+    // While the layout runs, queries widen by how far nodes may have moved;
+    // the grid is rebuilt once that exceeds this many cells
+    static constexpr float SPATIAL_MAX_DRIFT_CELLS = 0.5f;
+
+    // Largest vertex id accepted from a graph file; per-vertex arrays are
+    // indexed by id, so this bounds what a sparse file can make us allocate
+    static constexpr int MAX_FILE_ID = (1 << 24) - 1;
+
+    // Session snapshot file (F5 / F9, --snapshot overrides)
+    static constexpr const char *SNAPSHOT_PATH = "session.bfssnap";
+
     // DEBUG SETTINGS
     static constexpr bool DEBUG_PLACEMENT = false; // Set to true for debugging
   };
 
+  /* Force-Directed Layout Configuration */
+  struct Layout {
+    // Fruchterman-Reingold natural spring length
+    static constexpr float IDEAL_EDGE_LENGTH = Graph::MIN_NODE_DISTANCE;
+    static constexpr float INITIAL_TEMPERATURE = 60.0f; // max move per step
+    static constexpr float MIN_TEMPERATURE = 0.5f;
+    static constexpr float COOLING_FACTOR = 0.97f;
+    static constexpr float GRAVITY = 0.02f;
+
+    // Barnes-Hut opening angle: larger is faster but less accurate
+    static constexpr float THETA = 0.8f;
+    static constexpr int MAX_QUADTREE_DEPTH = 24;
+    static constexpr float MIN_DISTANCE_SQUARED = 1.0f;
+    static constexpr size_t MIN_BODIES_PER_THREAD = 512;
+  };
+
+  /* Camera Configuration */
+  struct Camera {
+    static constexpr float ZOOM_STEP = 1.15f; // Per mouse-wheel notch
+    // View size relative to the window: < 1 is zoomed in
+    static constexpr float MIN_ZOOM = 0.1f;
+    static constexpr float MAX_ZOOM = 200.0f;
+
+    // Level of detail by on-screen node radius in pixels (LodRenderer)
+    static constexpr float FULL_DETAIL_MIN_RADIUS = 10.0f;
+    static constexpr float QUAD_MIN_RADIUS = 1.0f;
+    static constexpr size_t MAX_QUAD_NODES = 200000; // Beyond: heatmap
+    static constexpr unsigned int HEATMAP_CELL_PIXELS = 4;
+    static constexpr size_t HEATMAP_MAX_SAMPLES = 250000; // Per raster
+    static constexpr int HEATMAP_MIN_ALPHA = 64;
+  };
+
+  /* Query server (--serve) */
+  struct Server {
+    // A batch waits at most this long for more queries once one is queued
+    static constexpr int BATCH_LINGER_MICROS = 200;
+    static constexpr size_t MAX_BATCH_QUERIES = 1024;
+    static constexpr int MAX_PATH_LANES = 8; // Parent arrays per batch
+    static constexpr size_t MAX_CLIENTS = 256;
+    // Unsent answers held per client before its input is no longer read
+    static constexpr size_t MAX_CLIENT_BACKLOG_BYTES = size_t{1} << 20;
+    static constexpr float REPORT_SECONDS = 5.0f;
+  };
+
+  /* Out-of-core mazes (--maze-gen, --maze-solve) */
+  struct Maze {
+    // Cells per tile side; one tile is TILE_SIDE^2 bits (512 KiB at 2048).
+    // Must be a multiple of 256 so tiles stay page aligned in the file
+    static constexpr unsigned int TILE_SIDE = 2048;
+    static constexpr unsigned int MAX_TILE_SIDE = 16384;
+    // Cells per maze side; keeps tile counts, file offsets and cell
+    // coordinates far from uint64 overflow (2^62 cells = 512 PiB)
+    static constexpr std::uint64_t MAX_SIDE = std::uint64_t{1} << 31;
+    static constexpr size_t CACHE_TILES = 256; // Mapped tiles per file
+    // Cross-tile frontier entries held in memory before spilling to disk
+    static constexpr size_t FRONTIER_BUDGET_ENTRIES = size_t{1} << 24;
+    static constexpr int LOOP_PERCENT = 5; // Extra walls knocked out
+    static constexpr float REPORT_SECONDS = 5.0f;
+  };
+
   /* UI Configuration */
   struct UI {
     static constexpr unsigned int TITLE_FONT_SIZE = 64;
@@ -100,16 +180,47 @@ public:
     static constexpr float LINE_HEIGHT = INFO_FONT_SIZE + 6;
     static constexpr float INFO_BOX_START_Y = 110.0f;
 
+    // frontier histogram inside the info box
+    static constexpr int HISTOGRAM_LINES = 3;
+    static constexpr int HISTOGRAM_MAX_BARS = 64;
+    static constexpr float HISTOGRAM_WIDTH = 480.0f;
+
     static constexpr const char *QUEUE_BOX_TITLE = "QUEUE:";
     static constexpr float QUEUE_BOX_WIDTH = 50.0f;
     static constexpr float QUEUE_BOX_HEIGHT = 40.0f;
     static constexpr unsigned int QUEUE_BOX_FONT_SIZE = 32;
+    static constexpr unsigned int QUEUE_ELIDED_FONT_SIZE = 16;
+    static constexpr float QUEUE_BOX_SPACING = 5.0f;
+    // When the queue overflows, 1/N of the visible slots show its tail
+    static constexpr size_t QUEUE_TAIL_DIVISOR = 4;
+    static constexpr long long QUEUE_SCROLL_PAGE = 20;
     static constexpr float UI_MARGIN = 20.0f;
+
+    // generation progress bars (bottom-right corner)
+    static constexpr float PROGRESS_BAR_WIDTH = 300.0f;
+    static constexpr float PROGRESS_BAR_HEIGHT = 28.0f;
+    static constexpr unsigned int PROGRESS_FONT_SIZE = 20;
   };
 
   /* Algorithm Configuration */
   struct Algorithm {
     static constexpr float DEFAULT_STEP_DELAY = 1.0f;
+
+    // Turbo auto-stepping: time spent stepping per frame
+    static constexpr float TURBO_FRAME_BUDGET_MS = 4.0f;
+    static constexpr int TURBO_STEPS_PER_CLOCK_CHECK = 32;
+    static constexpr float RATE_WINDOW_SECONDS = 0.5f;
+
+    // Connected components: below twice this many vertices, one thread
+    static constexpr size_t MIN_VERTICES_PER_THREAD = 4096;
+
+    // 0-1 BFS weights: edges up to this length are free, longer ones cost 1
+    static constexpr float FREE_EDGE_MAX_LENGTH =
+        Graph::MIN_NODE_DISTANCE * 1.5f;
+    // Traversal stats for Dijkstra and A* group settled nodes by distance
+    // in bands of one minimum node spacing (roughly one hop)
+    static constexpr std::uint32_t STATS_DISTANCE_BUCKET =
+        static_cast<std::uint32_t>(Graph::MIN_NODE_DISTANCE);
     static constexpr int MIN_NODES = 6;
     static constexpr int MAX_NODES = 12; // More nodes for larger window
     static constexpr int MAX_PLACEMENT_ATTEMPTS =
@@ -126,6 +237,14 @@ public:
     static constexpr sf::Color EDGE = sf::Color::Black;
     static constexpr sf::Color TEXT = sf::Color::Black;
     static constexpr sf::Color QUEUE_BOX = sf::Color::Yellow;
+    static constexpr sf::Color PROGRESS_BAR = sf::Color(100, 180, 255);
+    static constexpr sf::Color SELECTED = sf::Color::Blue;
+    static constexpr sf::Color TARGET = sf::Color::Magenta;
+    static constexpr sf::Color LOD_UNVISITED = sf::Color(150, 150, 150);
+    // Component colouring: pastel hues spaced by the golden angle
+    static constexpr float COMPONENT_SATURATION = 0.35f;
+    static constexpr float COMPONENT_VALUE = 1.0f;
+    static constexpr sf::Color HISTOGRAM = sf::Color(100, 180, 255);
   };
 
 private:
@@ -141,4 +260,8 @@ private:
 #define GRAPH_CONFIG Config::Graph
 #define UI_CONFIG Config::UI
 #define ALGO_CONFIG Config::Algorithm
+#define LAYOUT_CONFIG Config::Layout
+#define CAMERA_CONFIG Config::Camera
+#define SERVER_CONFIG Config::Server
+#define MAZE_CONFIG Config::Maze
 #define COLOR_CONFIG Config::Colors
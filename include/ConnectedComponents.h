@@ -0,0 +1,42 @@
+#pragma once
+#include "CompressedAdjacency.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Whole-graph connected components by a concurrent union-find. Threads take
+// contiguous vertex ranges and union every edge (u, v > u) into one shared
+// parent array of atomics. Roots are always linked larger-id-under-smaller by
+// CAS, so parent pointers only decrease and no locks are needed; find uses
+// path halving and never retries. The root of each component ends up being
+// its smallest vertex id, which makes the labelling deterministic regardless
+// of thread interleaving.
+class ConnectedComponents {
+public:
+  explicit ConnectedComponents(unsigned int threads = 0); // 0 = all cores
+  ~ConnectedComponents() = default;
+
+  // Label every vertex of the adjacency. Vertices with present[v] == 0 are
+  // skipped (ids freed by node removal) and labelled -1.
+  void run(const CompressedAdjacency &adjacency,
+           const std::vector<std::uint8_t> *present = nullptr);
+
+  // Components are numbered 0.. in order of their smallest vertex id
+  int getComponent(int vertex) const;
+  std::size_t getComponentCount() const { return m_sizes.size(); }
+  const std::vector<std::size_t> &getSizes() const { return m_sizes; }
+  std::size_t getLargestSize() const;
+  double getMicros() const { return m_micros; }
+
+private:
+  using Parent = std::atomic<std::uint32_t>;
+
+  unsigned int m_threads;
+  std::vector<int> m_labels;
+  std::vector<std::size_t> m_sizes;
+  double m_micros = 0.0;
+
+  static std::uint32_t find(Parent *parent, std::uint32_t vertex);
+  static void unite(Parent *parent, std::uint32_t a, std::uint32_t b);
+};
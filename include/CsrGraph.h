@@ -0,0 +1,48 @@
+#pragma once
+#include "CompressedAdjacency.h"
+#include "GraphConcept.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Plain compressed-sparse-row adjacency with Id-wide neighbor entries: one
+// offset array and one flat target array, so neighbors(v) is a contiguous
+// span the compiler can stream through. Trades CompressedAdjacency's small
+// footprint for decode-free access.
+template <std::integral Id = VertexId> class CsrGraph {
+public:
+  using VertexId = Id;
+
+  CsrGraph() = default;
+
+  // Decodes a compressed snapshot (ids must fit in Id)
+  explicit CsrGraph(const CompressedAdjacency &adjacency) {
+    const int count = adjacency.getVertexCount();
+    m_offsets.reserve(count + 1);
+    m_targets.reserve(adjacency.getEdgeCount());
+    for (int vertex = 0; vertex < count; ++vertex) {
+      for (int neighborId : adjacency.neighbors(vertex)) {
+        m_targets.push_back(static_cast<Id>(neighborId));
+      }
+      m_offsets.push_back(m_targets.size());
+    }
+  }
+
+  std::size_t getVertexCount() const { return m_offsets.size() - 1; }
+  std::size_t getEdgeCount() const { return m_targets.size(); }
+
+  std::span<const Id> neighbors(Id vertex) const {
+    return {m_targets.data() + m_offsets[vertex],
+            m_targets.data() + m_offsets[vertex + 1]};
+  }
+
+  std::size_t getByteSize() const {
+    return m_offsets.size() * sizeof(std::uint64_t) +
+           m_targets.size() * sizeof(Id);
+  }
+
+private:
+  std::vector<std::uint64_t> m_offsets{0}; // Edge counts can exceed Id
+  std::vector<Id> m_targets;
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+struct CullingBenchmarkOptions {
+  int graphs = 100;       // Random graphs, each with its own size and extent
+  int viewsPerGraph = 50; // Random view rectangles queried on each
+  std::uint64_t seed = 1;
+};
+
+// Headless check of SpatialIndex against brute-force visibility. Each
+// random graph mixes short chains with long random edges (so both the
+// gridded and the long-edge lists are exercised) and is queried with view
+// rectangles of every size, including ones partly or wholly off the grid.
+// Every node whose disc intersects a view and every edge whose bounding box
+// does must be returned; with no drift the edge result must be exact.
+// countNodes and sampleNodes (the heatmap's cell sampling) must agree with
+// the full node query. Each graph is then jittered by a known distance per
+// node, reported through addDrift(), and the stale index must still return
+// a superset. Prints build and query times.
+class CullingBenchmark {
+public:
+  explicit CullingBenchmark(CullingBenchmarkOptions options);
+  ~CullingBenchmark() = default;
+
+  // Returns false on the first query that misses something visible
+  bool run();
+
+private:
+  CullingBenchmarkOptions m_options;
+};
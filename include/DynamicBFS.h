@@ -0,0 +1,62 @@
+#pragma once
+#include "Graph.h"
+#include <cstddef>
+#include <vector>
+
+// Cost of the last incremental update next to the cost of a from-scratch BFS
+// on the current graph. Work is counted in vertices settled plus adjacency
+// entries scanned, so the two numbers are directly comparable. fullMicros
+// is fullWork at the throughput measured by the most recent full BFS, so it
+// tracks the graph as it is now without running one per edit.
+struct RepairReport {
+  size_t repairWork = 0;
+  size_t affectedVertices = 0;
+  double repairMicros = 0.0;
+  size_t fullWork = 0;
+  double fullMicros = 0.0;
+};
+
+// Single-source BFS distances and tree that are repaired in place when edges
+// are inserted or deleted instead of being recomputed. Reads adjacency from
+// the live Graph, so call the matching update right after mutating it.
+class DynamicBFS {
+public:
+  static constexpr int UNREACHED = -1;
+
+  explicit DynamicBFS(const Graph &graph);
+  ~DynamicBFS() = default;
+
+  void setSource(int source); // Full BFS from source
+  void clear();
+  bool hasSource() const { return m_source != UNREACHED; }
+  int getSource() const { return m_source; }
+
+  // Call after the graph gained/lost edge (u, v)
+  const RepairReport &edgeInserted(int u, int v);
+  const RepairReport &edgeDeleted(int u, int v);
+
+  int getDistance(int id) const;
+  int getParent(int id) const;
+  int getReachableCount() const { return m_reachable; }
+  int getMaxDistance() const; // O(1): top of the per-distance counts
+  const RepairReport &getLastReport() const { return m_report; }
+
+private:
+  const Graph &m_graph;
+  int m_source;
+  int m_reachable;
+  size_t m_reachableWork; // Sum of (1 + degree) over reachable vertices
+  std::vector<int> m_distance; // Indexed by node id; UNREACHED if none
+  std::vector<int> m_parent;
+  std::vector<int> m_distanceCounts; // Vertices per distance; last is > 0
+  double m_microsPerWork;            // From the last full BFS
+  RepairReport m_report;
+
+  void ensureCapacity(int id);
+  void recompute();
+  void markReached(int id);
+  void markUnreached(int id);
+  void setDistance(int id, int distance); // Keeps m_distanceCounts in step
+  void finishReport(size_t work, double micros);
+  bool isFinite(int id) const { return getDistance(id) != UNREACHED; }
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include "GraphConcept.h"
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Runtime-polymorphic view of any TraversableGraph: the design a
+// virtual GraphBackend interface would give, kept as the baseline the
+// templated kernels are measured against. Each neighbors() call is an
+// indirect call that copies the list into a scratch buffer, since the
+// backend's own range type can't cross the virtual boundary. The buffer
+// makes an ErasedGraph unsafe to share between threads.
+class ErasedGraph {
+public:
+  using VertexId = ::VertexId;
+
+  template <TraversableGraph G>
+  explicit ErasedGraph(const G &graph)
+      : m_backend(std::make_unique<Model<G>>(graph)) {}
+
+  std::size_t getVertexCount() const { return m_backend->vertexCount(); }
+
+  // Valid until the next call
+  std::span<const VertexId> neighbors(VertexId vertex) const {
+    m_scratch.clear();
+    m_backend->appendNeighbors(vertex, m_scratch);
+    return m_scratch;
+  }
+
+private:
+  struct Backend {
+    virtual ~Backend() = default;
+    virtual std::size_t vertexCount() const = 0;
+    virtual void appendNeighbors(VertexId vertex,
+                                 std::vector<VertexId> &out) const = 0;
+  };
+
+  template <TraversableGraph G> struct Model final : Backend {
+    explicit Model(const G &graph) : graph(graph) {}
+    std::size_t vertexCount() const override {
+      return graph.getVertexCount();
+    }
+    void appendNeighbors(VertexId vertex,
+                         std::vector<VertexId> &out) const override {
+      for (auto neighborId :
+           graph.neighbors(static_cast<typename G::VertexId>(vertex))) {
+        out.push_back(static_cast<VertexId>(neighborId));
+      }
+    }
+    const G &graph;
+  };
+
+  std::unique_ptr<Backend> m_backend;
+  mutable std::vector<VertexId> m_scratch;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include "Graph.h"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Incremental force-directed layout (Fruchterman-Reingold forces with a
+// Barnes-Hut quadtree for repulsion). Each call to step() runs one iteration
+// and writes the new positions back into the graph, clamped to the
+// GRAPH_CONFIG boundaries, so the layout animates across frames while the
+// temperature cools.
+class ForceLayout {
+public:
+  explicit ForceLayout(Graph &graph);
+  ~ForceLayout() = default;
+
+  void setEnabled(bool enable);
+  bool isEnabled() const { return m_enabled; }
+  bool isSettled() const;
+
+  // Restart from full temperature (e.g. after the graph changed)
+  void restart();
+
+  // One iteration; returns the largest distance any node moved (0 when
+  // disabled or settled)
+  float step();
+
+private:
+  // Flat quadtree; children are indices into m_cells, -1 when absent
+  struct Cell {
+    sf::Vector2f center;       // Geometric centre of the square
+    float halfSize;
+    sf::Vector2f centerOfMass; // Running sum until finalised
+    float mass;
+    int body;                  // First body of a leaf, else -1
+    int children[4];
+  };
+
+  Graph &m_graph;
+  bool m_enabled;
+  float m_temperature;
+
+  // Per-iteration snapshot of the graph in dense index space
+  std::vector<int> m_ids;
+  std::vector<sf::Vector2f> m_positions;
+  std::vector<sf::Vector2f> m_displacements;
+  std::vector<std::pair<int, int>> m_edges;
+  std::vector<Cell> m_cells;
+  // Next body in the same leaf, -1 at the end. Only leaves at
+  // MAX_QUADTREE_DEPTH hold more than one body.
+  std::vector<int> m_nextInLeaf;
+
+  void snapshotGraph();
+  void buildQuadtree();
+  void insertBody(int cellIndex, int body, int depth);
+  int createCell(sf::Vector2f center, float halfSize);
+  void computeRepulsion(size_t begin, size_t end);
+  sf::Vector2f repulsionOn(int body) const;
+  void applyAttraction();
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+// Recycling allocator for coroutine frames. Frames are rounded up to a
+// power-of-two size class and returned to a per-thread free list when the
+// coroutine is destroyed, so after the first traversal of a given shape
+// starting another one does not touch the heap. Oversized frames fall back
+// to ::operator new.
+class FramePool {
+public:
+  static void *allocate(std::size_t size);
+  static void deallocate(void *frame, std::size_t size) noexcept;
+
+  // Frames this thread had to get from the system allocator so far
+  static std::size_t getSystemAllocations();
+
+private:
+  static constexpr std::size_t MIN_CLASS_SHIFT = 6;  // 64 B
+  static constexpr std::size_t MAX_CLASS_SHIFT = 16; // 64 KiB
+  static constexpr std::size_t CLASS_COUNT =
+      MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  // Owns the cached blocks and releases them when the thread exits
+  struct FreeLists {
+    std::array<FreeBlock *, CLASS_COUNT> heads{};
+    std::size_t systemAllocations = 0;
+    ~FreeLists();
+  };
+
+  static FreeLists &freeLists();
+  static std::size_t sizeClass(std::size_t size);
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include "FramePool.h"
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Minimal pull-style coroutine generator. Each next() resumes the coroutine
+// until its next co_yield; the yielded value is stored in the promise and
+// read through value(), so yielding never allocates. Frames come from
+// FramePool.
+template <typename T> class Generator {
+public:
+  struct promise_type {
+    T m_value{};
+    std::exception_ptr m_exception;
+
+    Generator get_return_object() {
+      return Generator(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    std::suspend_always yield_value(T value) noexcept {
+      m_value = std::move(value);
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() { m_exception = std::current_exception(); }
+
+    static void *operator new(std::size_t size) {
+      return FramePool::allocate(size);
+    }
+    static void operator delete(void *frame, std::size_t size) noexcept {
+      FramePool::deallocate(frame, size);
+    }
+  };
+
+  Generator() = default;
+  Generator(Generator &&other) noexcept
+      : m_handle(std::exchange(other.m_handle, nullptr)) {}
+  Generator &operator=(Generator &&other) noexcept {
+    if (this != &other) {
+      destroy();
+      m_handle = std::exchange(other.m_handle, nullptr);
+    }
+    return *this;
+  }
+  Generator(const Generator &) = delete;
+  Generator &operator=(const Generator &) = delete;
+  ~Generator() { destroy(); }
+
+  // Advance to the next value; false once the coroutine has finished
+  bool next() {
+    if (!m_handle || m_handle.done())
+      return false;
+    m_handle.resume();
+    if (m_handle.promise().m_exception) {
+      std::rethrow_exception(m_handle.promise().m_exception);
+    }
+    return !m_handle.done();
+  }
+
+  const T &value() const { return m_handle.promise().m_value; }
+  bool isActive() const { return m_handle && !m_handle.done(); }
+
+private:
+  std::coroutine_handle<promise_type> m_handle;
+
+  explicit Generator(std::coroutine_handle<promise_type> handle)
+      : m_handle(handle) {}
+
+  void destroy() {
+    if (m_handle) {
+      m_handle.destroy();
+      m_handle = nullptr;
+    }
+  }
+};
@@ -1,31 +1,83 @@
 #pragma once
 #include "Node.h"
+#include "Philox.h"
 #include <SFML/Graphics.hpp>
-#include <random>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Shared between the UI thread and a background generation job. The job
+// publishes per-phase progress in [0, 1] and polls `cancelled` between units
+// of work so an in-flight generation can be abandoned quickly.
+struct GenerationProgress {
+  std::atomic<bool> cancelled{false};
+  std::atomic<float> placement{0.0f};
+  std::atomic<float> connectivity{0.0f};
+};
+
+class SnapshotReader;
+class SnapshotWriter;
 
 class Graph {
 public:
   Graph();
   ~Graph() = default;
+  Graph(Graph &&) = default;
+  Graph &operator=(Graph &&) = default;
 
   // Graph construction
   void addNode(int id, sf::Vector2f position);
   void addEdge(int from, int to);
+  void removeEdge(int from, int to);
+  void removeNode(int id); // Also drops every edge touching it
+  bool hasEdge(int from, int to) const;
+  int getNextId() const; // One past the largest id in use
   void clear();
 
+  // Renumber nodes so that order[k] becomes id k; `order` lists every
+  // current id once. Nodes and their neighbor lists (ascending new ids) are
+  // reallocated in new-id order, so they sit in memory in the order an
+  // id-indexed traversal walks them. Display labels are kept.
+  void relabel(const std::vector<int> &order);
+
   // Getters
   NodePtr getNode(int id) const;
+  int getLabel(int id) const; // Display label for id, or id if unknown
   const std::unordered_map<int, NodePtr> &getNodes() const { return m_nodes; }
 
   // Interaction
   int getNodeAtPosition(sf::Vector2f position) const;
 
-  // Rendering
+  // Layout helper: clamp a position into the GRAPH_CONFIG boundaries
+  sf::Vector2f clampToBounds(const sf::Vector2f &position) const;
+
+  // Rendering: everything, or only the given edges and nodes (for example a
+  // SpatialIndex query for the visible area)
   void draw(sf::RenderWindow &window, sf::Font &font) const;
+  void draw(sf::RenderWindow &window, sf::Font &font,
+            const std::vector<std::pair<int, int>> &edges,
+            const std::vector<int> &nodeIds) const;
+
+  // Graph generation. The result is a pure function of (seed, stream), so
+  // graph k of a batch can be regenerated on its own from (seed, k). Returns
+  // false if cancelled through `progress`, in which case the graph is left
+  // partially built and should be discarded.
+  bool generateSampleGraph(std::uint64_t seed, std::uint64_t stream = 0,
+                           GenerationProgress *progress = nullptr);
 
-  // Graph generation
-  void generateSampleGraph();
+  // Persistence (plain-text "v id x y [label]" / "e from to" lines; the
+  // label is written only when it differs from the id)
+  void save(std::ostream &out) const;
+  bool loadFromFile(const std::string &path);
+
+  // Binary snapshot sections (see Snapshot.h). restoreSnapshot leaves the
+  // graph untouched and returns false if the sections are inconsistent.
+  void writeSnapshot(SnapshotWriter &writer) const;
+  bool restoreSnapshot(const SnapshotReader &reader);
 
 private:
   std::unordered_map<int, NodePtr> m_nodes;
@@ -34,17 +86,11 @@ private:
                 const Node &to) const;
 
   // PLACEMENT STRATEGY HELPERS
-  sf::Vector2f generateRingPosition(
-      std::mt19937 &gen, std::uniform_real_distribution<float> &angleDist,
-      std::uniform_real_distribution<float> &radiusDist,
-      std::uniform_real_distribution<float> &edgeProbDist) const;
-  sf::Vector2f
-  generateGridPosition(int nodeIndex, int totalNodes,
-                       std::uniform_real_distribution<float> &edgeProbDist,
-                       std::mt19937 &gen) const;
-  sf::Vector2f generateRandomPosition(std::mt19937 &gen) const;
+  sf::Vector2f generateRingPosition(Philox4x32 &rng) const;
+  sf::Vector2f generateGridPosition(int nodeIndex, int totalNodes,
+                                    Philox4x32 &rng) const;
+  sf::Vector2f generateRandomPosition(Philox4x32 &rng) const;
   bool
   isValidPosition(const sf::Vector2f &newPos,
                   const std::vector<sf::Vector2f> &existingPositions) const;
-  sf::Vector2f clampToBounds(const sf::Vector2f &position) const;
 };
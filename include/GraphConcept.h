@@ -0,0 +1,28 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+
+// Default id width of the templated graph backends (CsrGraph, GridGraph)
+// and the id type of ErasedGraph. 32-bit ids halve the memory traffic of
+// neighbor arrays and queues; instantiate a backend with std::uint64_t for
+// graphs past 4G vertices.
+using VertexId = std::uint32_t;
+
+// What a traversal kernel needs from a graph: an integral id type, a vertex
+// count (ids are dense in [0, count)) and a forward range of neighbor ids
+// per vertex. Kernels are instantiated per backend, so neighbor access is
+// inlined into the loop instead of going through a virtual call.
+template <typename G>
+concept TraversableGraph =
+    std::integral<typename G::VertexId> &&
+    requires(const G &graph, typename G::VertexId vertex) {
+      { graph.getVertexCount() } -> std::convertible_to<std::size_t>;
+      { graph.neighbors(vertex) } -> std::ranges::forward_range;
+    } &&
+    std::convertible_to<
+        std::ranges::range_value_t<decltype(std::declval<const G &>().neighbors(
+            std::declval<typename G::VertexId>()))>,
+        typename G::VertexId>;
@@ -0,0 +1,46 @@
+#pragma once
+#include "Graph.h"
+#include <cstddef>
+#include <vector>
+
+enum class ReorderStrategy { REVERSE_CUTHILL_MCKEE, BFS_ORDER, HILBERT_CURVE };
+
+// Locality of the current labelling: bandwidth is the largest |u - v| over
+// all edges, average gap is the mean |u - v|. Smaller means neighbors sit
+// closer together in any id-indexed array. The last two are measured on
+// the arrays a traversal actually uses: the CompressedAdjacency the
+// visualizer builds, and a full BFS over it (best of a few runs) from the
+// node with the smallest label, which is the same node on both sides.
+struct LocalityMetrics {
+  int bandwidth = 0;
+  double averageGap = 0.0;
+  std::size_t adjacencyBytes = 0;
+  double bfsMicros = 0.0;
+};
+
+struct ReorderReport {
+  ReorderStrategy strategy;
+  LocalityMetrics before;
+  LocalityMetrics after;
+};
+
+// Relabels vertices so that neighbors get nearby ids. The graph is rewritten
+// through Graph::relabel, which keeps each node's original id as its display
+// label.
+class GraphReorder {
+public:
+  static ReorderReport apply(Graph &graph, ReorderStrategy strategy);
+  static LocalityMetrics measure(const Graph &graph);
+  static const char *getName(ReorderStrategy strategy);
+
+private:
+  static constexpr int MEASURE_RUNS = 3;
+
+  // Each returns the old ids in their new order (new id = position)
+  static std::vector<int> reverseCuthillMcKeeOrder(const Graph &graph);
+  static std::vector<int> bfsOrder(const Graph &graph);
+  static std::vector<int> hilbertOrder(const Graph &graph);
+
+  static std::vector<int> sortedIds(const Graph &graph);
+  static int findPeripheralNode(const Graph &graph, int start);
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include "GraphConcept.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Implicit 4-connected width x height grid: no adjacency is stored and
+// neighbors are computed from the id, so the graph costs no memory and the
+// kernel's only loads are its own level and queue arrays. Neighbors are
+// yielded in ascending id order (up, left, right, down) like the sorted
+// lists of the stored backends.
+template <std::integral Id = VertexId> class GridGraph {
+public:
+  using VertexId = Id;
+
+  // At most four ids, held by value
+  class NeighborList {
+  public:
+    const Id *begin() const { return m_ids.data(); }
+    const Id *end() const { return m_ids.data() + m_count; }
+
+    void push(Id id) { m_ids[m_count++] = id; }
+
+  private:
+    std::array<Id, 4> m_ids;
+    std::uint8_t m_count = 0;
+  };
+
+  GridGraph(Id width, Id height) : m_width(width), m_height(height) {}
+
+  std::size_t getVertexCount() const {
+    return static_cast<std::size_t>(m_width) * m_height;
+  }
+  Id getWidth() const { return m_width; }
+  Id getHeight() const { return m_height; }
+
+  NeighborList neighbors(Id vertex) const {
+    const Id row = vertex / m_width;
+    const Id col = vertex - row * m_width;
+    NeighborList list;
+    if (row > 0)
+      list.push(vertex - m_width);
+    if (col > 0)
+      list.push(vertex - 1);
+    if (col + 1 < m_width)
+      list.push(vertex + 1);
+    if (row + 1 < m_height)
+      list.push(vertex + m_width);
+    return list;
+  }
+
+private:
+  Id m_width;
+  Id m_height;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include "Graph.h"
+#include "SpatialIndex.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <future>
+#include <utility>
+#include <vector>
+
+enum class LodTier { FULL, QUADS, HEATMAP };
+
+// Draws the part of the graph inside the camera at a level of detail chosen
+// from the on-screen node size:
+//
+//   FULL     circles, outlines and labels, one draw call per primitive
+//   QUADS    unlabelled state-coloured quads and hairline edges, batched
+//            into two vertex arrays
+//   HEATMAP  node density per screen cell, tinted by node state, rasterised
+//            into a texture on a worker thread
+//
+// In the heatmap tier the UI thread draws the last texture. It snapshots
+// at most CAMERA_CONFIG::HEATMAP_MAX_SAMPLES nodes, sampled straight from
+// the SpatialIndex cells, and only when the previous raster has finished
+// and the picture is out of date: the camera moved or invalidate() was
+// called. Frame time therefore does not depend on how many nodes are in
+// view, and an unchanged scene is not rasterised again.
+class LodRenderer {
+public:
+  LodRenderer() = default;
+  ~LodRenderer() = default; // The pending future waits for the worker
+
+  void draw(sf::RenderWindow &window, sf::Font &font, const Graph &graph,
+            const SpatialIndex &index, const sf::View &camera);
+
+  // True while a heatmap raster is being built on the worker
+  bool isRasterPending() const { return m_pendingRaster.valid(); }
+
+  // Uploads a finished raster; true if the texture changed, i.e. the scene
+  // needs redrawing. Waiting on the worker is not itself a reason to redraw.
+  bool pollRaster();
+
+  // Node states or positions changed: the next heatmap frame rasterises
+  // again
+  void invalidate() { m_heatmapDirty = true; }
+
+  LodTier getTier() const { return m_tier; }
+  static const char *getName(LodTier tier);
+  std::size_t getDrawnNodes() const { return m_visibleNodes.size(); }
+  std::size_t getDrawnEdges() const { return m_visibleEdges.size(); }
+
+private:
+  struct HeatmapSample {
+    sf::Vector2f position;
+    std::uint8_t state; // NodeState
+  };
+
+  struct Raster {
+    sf::FloatRect area;
+    sf::Vector2u size;
+    std::vector<std::uint8_t> pixels; // RGBA
+  };
+
+  LodTier m_tier = LodTier::FULL;
+  std::vector<int> m_visibleNodes;
+  std::vector<std::pair<int, int>> m_visibleEdges;
+
+  // QUADS tier geometry, reused across frames
+  sf::VertexArray m_edgeLines{sf::PrimitiveType::Lines};
+  sf::VertexArray m_nodeQuads{sf::PrimitiveType::Triangles};
+
+  // HEATMAP tier: the raster being built and the last one uploaded, and
+  // what the next one is compared against
+  std::future<Raster> m_pendingRaster;
+  sf::FloatRect m_requestedArea;
+  bool m_heatmapDirty = true;
+  sf::Texture m_heatmap;
+  sf::FloatRect m_heatmapArea;
+  bool m_hasHeatmap = false;
+
+  void drawQuads(sf::RenderWindow &window, const Graph &graph);
+  void drawHeatmap(sf::RenderWindow &window, const Graph &graph,
+                   const SpatialIndex &index, const sf::FloatRect &area);
+  static Raster rasterize(std::vector<HeatmapSample> samples,
+                          sf::FloatRect area, sf::Vector2u size);
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <memory>
+#include <optional>
 #include <vector>
 
 enum class NodeState { UNVISITED, VISITED, CURRENT, IN_QUEUE };
@@ -11,13 +12,33 @@ public:
 
   // Getters
   int getId() const { return m_id; }
+  int getLabel() const { return m_label; } // Original id, kept for display
   sf::Vector2f getPosition() const { return m_position; }
   NodeState getState() const { return m_state; }
+  bool isSelected() const { return m_selected; }
+  bool isTarget() const { return m_target; }
+  sf::Color getStateColor() const; // Fill colour for the current state
   const std::vector<int> &getNeighbors() const { return m_neighbors; }
 
   // Setters
   void setState(NodeState state) { m_state = state; }
+  void setPosition(sf::Vector2f position) { m_position = position; }
+  void setSelected(bool selected) { m_selected = selected; }
+  void setTarget(bool target) { m_target = target; }
+  // Fill used instead of the UNVISITED colour (component colouring)
+  void setComponentColor(std::optional<sf::Color> color) {
+    m_componentColor = color;
+  }
   void addNeighbor(int neighborId);
+  void removeNeighbor(int neighborId);
+  bool hasNeighbor(int neighborId) const;
+
+  // Used by Graph::relabel; the display label is left untouched
+  void setId(int id) { m_id = id; }
+  void setLabel(int label) { m_label = label; } // Snapshot/file restore
+  void setNeighbors(std::vector<int> neighbors) {
+    m_neighbors = std::move(neighbors);
+  }
 
   // Rendering
   void draw(sf::RenderWindow &window, sf::Font &font) const;
@@ -27,12 +48,14 @@ public:
 
 private:
   int m_id;
+  int m_label;
   sf::Vector2f m_position;
   float m_radius;
   NodeState m_state;
+  bool m_selected;
+  bool m_target; // Goal of the next traversal
+  std::optional<sf::Color> m_componentColor;
   std::vector<int> m_neighbors;
-
-  sf::Color getStateColor() const;
 };
 
 using NodePtr = std::shared_ptr<Node>;
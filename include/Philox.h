@@ -0,0 +1,87 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// Philox4x32-10 counter-based random number generator (Salmon et al., 2011).
+//
+// Every output is a pure function of (key, counter), so a generator seeded
+// with (seed, stream) produces the same sequence on any thread or machine and
+// independent streams never share state. Satisfies UniformRandomBitGenerator,
+// but prefer the uniform() helpers below: the std distributions are
+// implementation-defined and would break cross-platform reproducibility.
+class Philox4x32 {
+public:
+  using result_type = std::uint32_t;
+
+  Philox4x32(std::uint64_t seed, std::uint64_t stream = 0)
+      : m_key{static_cast<std::uint32_t>(seed),
+              static_cast<std::uint32_t>(seed >> 32)},
+        m_counter{0, 0, static_cast<std::uint32_t>(stream),
+                  static_cast<std::uint32_t>(stream >> 32)},
+        m_index(4) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    if (m_index == 4) {
+      m_block = generateBlock();
+      incrementCounter();
+      m_index = 0;
+    }
+    return m_block[m_index++];
+  }
+
+  // Uniform float in [lo, hi) built from the top 24 bits of one output
+  float uniform(float lo, float hi) {
+    constexpr float scale = 1.0f / 16777216.0f; // 2^-24
+    return lo + (hi - lo) * static_cast<float>((*this)() >> 8) * scale;
+  }
+
+  // Uniform integer in [lo, hi] (multiply-shift; bias is negligible for the
+  // small ranges used by graph generation)
+  int uniformInt(int lo, int hi) {
+    std::uint64_t range = static_cast<std::uint64_t>(hi - lo) + 1;
+    return lo + static_cast<int>((static_cast<std::uint64_t>((*this)()) *
+                                  range) >>
+                                 32);
+  }
+
+private:
+  static constexpr std::uint32_t MULTIPLIER_0 = 0xD2511F53;
+  static constexpr std::uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+  static constexpr std::uint32_t WEYL_0 = 0x9E3779B9;
+  static constexpr std::uint32_t WEYL_1 = 0xBB67AE85;
+  static constexpr int ROUNDS = 10;
+
+  std::array<std::uint32_t, 2> m_key;
+  std::array<std::uint32_t, 4> m_counter;
+  std::array<std::uint32_t, 4> m_block{};
+  int m_index;
+
+  std::array<std::uint32_t, 4> generateBlock() const {
+    std::array<std::uint32_t, 4> c = m_counter;
+    std::array<std::uint32_t, 2> k = m_key;
+    for (int round = 0; round < ROUNDS; ++round) {
+      std::uint64_t p0 = static_cast<std::uint64_t>(MULTIPLIER_0) * c[0];
+      std::uint64_t p1 = static_cast<std::uint64_t>(MULTIPLIER_1) * c[2];
+      c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0],
+           static_cast<std::uint32_t>(p1),
+           static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1],
+           static_cast<std::uint32_t>(p0)};
+      k[0] += WEYL_0;
+      k[1] += WEYL_1;
+    }
+    return c;
+  }
+
+  // The low 64 bits of the counter index blocks; the high 64 bits hold the
+  // stream id and are never touched
+  void incrementCounter() {
+    if (++m_counter[0] == 0)
+      ++m_counter[1];
+  }
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include "BatchedBFS.h"
+#include "CompressedAdjacency.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct QueryServerOptions {
+  std::string socketPath;
+  std::string graphPath; // Empty: serve the sample graph for `seed`
+  std::uint64_t seed = 0;
+  // Return from run() once this many clients have disconnected (0 = serve
+  // until interrupted); lets a benchmark drive a server in-process
+  std::size_t exitAfterClients = 0;
+};
+
+// Headless BFS query service on a Unix domain socket. The graph is loaded
+// once; clients then send fixed-size binary requests and may pipeline as
+// many as they like. All integers are little-endian.
+//
+//   request  (16 bytes): u32 id | u8 kind | u8[3] 0 | i32 source | i32 target
+//   response (16 bytes + 4 * count):
+//            u32 id | u8 kind | u8 status | u16 0 | i32 value | u32 count |
+//            count x u32 payload
+//
+// kind is a QueryKind. value is the distance in hops (-1 if unreachable),
+// 1/0 for REACHABLE and the eccentricity for LEVELS. The payload is the
+// per-level vertex counts for LEVELS and the path (source first) for PATH.
+//
+// A single-threaded poll() loop reads every client. Queries that arrive
+// within SERVER_CONFIG::BATCH_LINGER_MICROS of the oldest waiting one are
+// answered together by BatchedBFS, 64 sources per sweep. Latency (receipt
+// to response) and throughput are reported every REPORT_SECONDS and again
+// on SIGINT/SIGTERM.
+//
+// A client that pipelines faster than it reads would otherwise make the
+// server buffer its answers without bound. Once a client's unsent output
+// passes SERVER_CONFIG::MAX_CLIENT_BACKLOG_BYTES the server stops polling it
+// for input, leaving further requests in the socket, and resumes when the
+// backlog has drained below the cap.
+class QueryServer {
+public:
+  explicit QueryServer(QueryServerOptions options);
+  ~QueryServer();
+
+  // Serves until interrupted; returns false if the graph or socket can't be
+  // set up
+  bool run();
+
+  // Largest unsent output held for any one client so far
+  std::size_t getPeakBacklog() const { return m_peakBacklog; }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Status : std::uint8_t { OK = 0, BAD_VERTEX = 1, BAD_KIND = 2 };
+
+  struct Client {
+    std::vector<std::uint8_t> in;  // Unparsed bytes (a partial request)
+    std::vector<std::uint8_t> out; // Encoded responses not yet sent
+    std::size_t sent = 0;          // Bytes of `out` already written
+    std::size_t waiting = 0;       // Queries queued for the next batch
+    bool hungUp = false;           // Peer shut down its sending side
+  };
+
+  struct Pending {
+    int fd;
+    std::uint32_t id;
+    Clock::time_point received;
+  };
+
+  QueryServerOptions m_options;
+  CompressedAdjacency m_adjacency;
+  std::vector<std::uint8_t> m_present; // Vertex ids that exist
+  std::unique_ptr<BatchedBFS> m_bfs;
+
+  int m_listenFd = -1;
+  std::unordered_map<int, Client> m_clients;
+
+  // Parsed, validated queries waiting for the next batch (parallel arrays)
+  std::vector<BfsQuery> m_queries;
+  std::vector<Pending> m_pending;
+
+  // Counters since the last report, and since start
+  std::vector<double> m_latencies; // Microseconds
+  std::size_t m_batches = 0;
+  std::size_t m_lanes = 0;
+  std::size_t m_totalQueries = 0;
+  std::size_t m_totalBatches = 0;
+  std::size_t m_closedClients = 0;
+  std::size_t m_peakBacklog = 0;
+  Clock::time_point m_reportStart;
+  Clock::time_point m_serveStart;
+
+  bool loadGraph();
+  bool openSocket();
+  void acceptClients();
+  static std::size_t getBacklog(const Client &client) {
+    return client.out.size() - client.sent;
+  }
+  bool readClient(int fd, Client &client); // false: disconnected
+  bool writeClient(int fd, Client &client); // false: connection broken
+  void flushClients();
+  void closeClient(int fd); // Also drops its unanswered queries
+  void parseRequests(int fd, Client &client);
+  void answerPending();
+  void respond(int fd, std::uint32_t id, QueryKind kind, Status status,
+               int value, const std::vector<std::uint32_t> &payload);
+  void report(bool final);
+};
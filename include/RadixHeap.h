@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Monotone priority queue for 32-bit integer keys (Ahuja et al., 1990).
+// Keys pushed must not be smaller than the last key popped, which holds for
+// Dijkstra and for A* with a consistent heuristic. Entry e lives in bucket
+// bit_width(e.key ^ last), so a pop only redistributes the one bucket that
+// holds the new minimum and each entry moves down at most 32 times.
+template <typename T> class RadixHeap {
+public:
+  using Entry = std::pair<std::uint32_t, T>;
+
+  RadixHeap() = default;
+
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+
+  void push(std::uint32_t key, const T &value) {
+    m_buckets[bucketIndex(key)].emplace_back(key, value);
+    ++m_size;
+  }
+
+  // Removes and returns an entry with the smallest key
+  Entry pop() {
+    if (m_buckets[0].empty()) {
+      size_t index = 1;
+      while (m_buckets[index].empty())
+        ++index;
+
+      std::vector<Entry> &bucket = m_buckets[index];
+      m_last = bucket.front().first;
+      for (const Entry &entry : bucket) {
+        if (entry.first < m_last)
+          m_last = entry.first;
+      }
+      for (const Entry &entry : bucket) {
+        m_buckets[bucketIndex(entry.first)].push_back(entry);
+      }
+      bucket.clear();
+    }
+
+    Entry entry = std::move(m_buckets[0].back());
+    m_buckets[0].pop_back();
+    --m_size;
+    return entry;
+  }
+
+  // Keeps bucket allocations for the next traversal
+  void clear() {
+    for (auto &bucket : m_buckets)
+      bucket.clear();
+    m_last = 0;
+    m_size = 0;
+  }
+
+  // Snapshot support: the smallest key that may still be pushed, every
+  // entry in no particular order, and an empty heap that resumes at `last`
+  std::uint32_t getLast() const { return m_last; }
+  template <typename F> void forEach(F &&visit) const {
+    for (const auto &bucket : m_buckets) {
+      for (const Entry &entry : bucket)
+        visit(entry);
+    }
+  }
+  void restart(std::uint32_t last) {
+    clear();
+    m_last = last;
+  }
+
+private:
+  static constexpr size_t BUCKET_COUNT = 33;
+
+  std::array<std::vector<Entry>, BUCKET_COUNT> m_buckets;
+  std::uint32_t m_last = 0;
+  size_t m_size = 0;
+
+  size_t bucketIndex(std::uint32_t key) const {
+    return static_cast<size_t>(std::bit_width(key ^ m_last));
+  }
+};
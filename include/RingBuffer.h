@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Queue over a power-of-two circular buffer. Unlike std::queue it supports
+// O(1) indexed access from the front, so views can read any window of the
+// queue without copying it. push_front makes it usable as the deque of a
+// 0-1 BFS.
+template <typename T> class RingBuffer {
+public:
+  RingBuffer() = default;
+
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+  size_t capacity() const { return m_storage.size(); }
+
+  const T &front() const { return m_storage[m_head]; }
+  const T &back() const { return (*this)[m_size - 1]; }
+
+  // i = 0 is the front
+  const T &operator[](size_t i) const {
+    return m_storage[(m_head + i) & (m_storage.size() - 1)];
+  }
+
+  void push_back(const T &value) {
+    if (m_size == m_storage.size()) {
+      grow(m_storage.empty() ? INITIAL_CAPACITY : m_storage.size() * 2);
+    }
+    m_storage[(m_head + m_size) & (m_storage.size() - 1)] = value;
+    ++m_size;
+  }
+
+  void push_front(const T &value) {
+    if (m_size == m_storage.size()) {
+      grow(m_storage.empty() ? INITIAL_CAPACITY : m_storage.size() * 2);
+    }
+    m_head = (m_head - 1) & (m_storage.size() - 1);
+    m_storage[m_head] = value;
+    ++m_size;
+  }
+
+  void pop_front() {
+    m_head = (m_head + 1) & (m_storage.size() - 1);
+    --m_size;
+  }
+
+  // Keeps the allocation so a new traversal doesn't regrow it
+  void clear() {
+    m_head = 0;
+    m_size = 0;
+  }
+
+  void reserve(size_t count) {
+    size_t capacity = m_storage.empty() ? INITIAL_CAPACITY : m_storage.size();
+    while (capacity < count)
+      capacity *= 2;
+    if (capacity > m_storage.size())
+      grow(capacity);
+  }
+
+private:
+  static constexpr size_t INITIAL_CAPACITY = 16;
+
+  std::vector<T> m_storage;
+  size_t m_head = 0;
+  size_t m_size = 0;
+
+  // Unwraps the contents to the start of the new buffer
+  void grow(size_t capacity) {
+    std::vector<T> storage(capacity);
+    for (size_t i = 0; i < m_size; ++i) {
+      storage[i] = std::move(m_storage[(m_head + i) & (m_storage.size() - 1)]);
+    }
+    m_storage = std::move(storage);
+    m_head = 0;
+  }
+};
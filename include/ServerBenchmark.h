@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+class CompressedAdjacency;
+
+struct ServerBenchmarkOptions {
+  int vertices = 100000; // Random graph with average degree `degree`
+  int degree = 8;
+  int batchQueries = 256; // Per kind, for the batched vs. one-by-one run
+  int clients = 8;
+  int queriesPerClient = 20000;
+  std::uint64_t seed = 1;
+};
+
+// Headless benchmark behind the query server numbers, in two parts.
+//
+// Batching: the same random LEVELS and PATH queries answered by BatchedBFS
+// and by one plain BFS per query, with the answers compared.
+//
+// Serving: a QueryServer on a temporary socket, driven in-process by
+// concurrent clients that pipeline mixed queries (and a few invalid ones)
+// while reading replies. One client reads slowly, so the server's output
+// cap has to hold it back. Every reply is checked against a reference BFS:
+// status, value, LEVELS histograms, and PATH validity and length.
+class ServerBenchmark {
+public:
+  explicit ServerBenchmark(ServerBenchmarkOptions options);
+  ~ServerBenchmark() = default;
+
+  // Returns false on any wrong or missing answer
+  bool run();
+
+private:
+  ServerBenchmarkOptions m_options;
+
+  bool runBatching(const CompressedAdjacency &adjacency);
+  bool runServing(const CompressedAdjacency &adjacency,
+                  const std::string &graphPath);
+};
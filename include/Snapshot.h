@@ -0,0 +1,148 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Sections of a snapshot file; each holds one flat array
+enum class SnapshotSection : std::uint32_t {
+  // Graph
+  NODE_IDS,
+  NODE_LABELS,
+  NODE_POSITIONS,
+  NODE_FLAGS,       // Bit 0: traversal target
+  NEIGHBOR_OFFSETS, // Node i's neighbors are NEIGHBORS[off[i], off[i + 1])
+  NEIGHBORS,
+
+  // Traversal (BFSVisualizer)
+  TRAVERSAL, // One fixed-size record of scalars
+  LEVELS,
+  PARENTS,
+  DISTANCES,
+  SETTLED,
+  QUEUE, // Front first
+  HEAP_KEYS,
+  HEAP_VALUES,
+  VISIT_ORDER,
+  LEVEL_STATS,
+};
+
+// One row of the section table
+struct SnapshotTableEntry {
+  std::uint32_t section;
+  std::uint32_t elementSize;
+  std::uint64_t offset; // From the start of the file
+  std::uint64_t count;  // Elements
+};
+
+// Builds a session snapshot in memory. add() copies a span, or takes over a
+// vector passed by rvalue without copying it. Either way the writer owns its
+// arrays, so it can be captured on the UI thread and written out by
+// writeFile() on a worker while the session keeps changing.
+//
+// File layout: a 64-byte header ("BFSSNAP", version, section count, file
+// size), the section table (id, element size, offset, count per section),
+// then each array 64-byte aligned, in host byte order. Snapshots are meant
+// for resuming on the same build and machine, not for interchange.
+class SnapshotWriter {
+public:
+  template <typename T>
+  void add(SnapshotSection section, std::span<const T> data) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    auto bytes = std::make_shared<std::vector<std::uint8_t>>(data.size_bytes());
+    if (!data.empty())
+      std::memcpy(bytes->data(), data.data(), data.size_bytes());
+    addEntry(section, sizeof(T), data.size(), bytes, bytes->data());
+  }
+
+  template <typename T>
+  void add(SnapshotSection section, const std::vector<T> &data) {
+    add(section, std::span<const T>(data));
+  }
+
+  // Arrays built only for the snapshot are moved in rather than copied
+  template <typename T>
+  void add(SnapshotSection section, std::vector<T> &&data) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    auto owned = std::make_shared<std::vector<T>>(std::move(data));
+    addEntry(section, sizeof(T), owned->size(), owned, owned->data());
+  }
+
+  template <typename T> void addValue(SnapshotSection section, const T &v) {
+    add(section, std::span<const T>(&v, 1));
+  }
+
+  // Writes to path.tmp and renames it over path, so a crash mid-write never
+  // leaves a truncated snapshot behind
+  bool writeFile(const std::string &path) const;
+
+  std::size_t getByteSize() const { return m_byteSize; } // Array data only
+
+private:
+  struct Entry {
+    SnapshotSection section;
+    std::uint32_t elementSize;
+    std::uint64_t count;
+    std::shared_ptr<const void> owner; // Keeps `data` alive
+    const void *data;
+  };
+
+  std::vector<Entry> m_entries;
+  std::size_t m_byteSize = 0;
+
+  void addEntry(SnapshotSection section, std::uint32_t elementSize,
+                std::uint64_t count, std::shared_ptr<const void> owner,
+                const void *data) {
+    m_byteSize += elementSize * count;
+    m_entries.push_back(
+        {section, elementSize, count, std::move(owner), data});
+  }
+};
+
+// Read-only view of a snapshot file mapped with mmap. Arrays are returned as
+// spans into the mapping, so opening costs a header check and restoring is
+// a straight copy out of the page cache with no parsing.
+class SnapshotReader {
+public:
+  SnapshotReader() = default;
+  ~SnapshotReader();
+  SnapshotReader(const SnapshotReader &) = delete;
+  SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+  // Maps the file and validates the header and section table
+  bool open(const std::string &path);
+
+  // Empty if the section is missing or holds another element type
+  template <typename T> std::span<const T> get(SnapshotSection section) const {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const SnapshotTableEntry *entry = find(section);
+    if (!entry || entry->elementSize != sizeof(T))
+      return {};
+    return {reinterpret_cast<const T *>(m_data + entry->offset),
+            static_cast<std::size_t>(entry->count)};
+  }
+
+  template <typename T>
+  bool getValue(SnapshotSection section, T &value) const {
+    std::span<const T> data = get<T>(section);
+    if (data.size() != 1)
+      return false;
+    value = data[0];
+    return true;
+  }
+
+  bool has(SnapshotSection section) const { return find(section) != nullptr; }
+  std::size_t getFileSize() const { return m_size; }
+
+private:
+  const std::uint8_t *m_data = nullptr;
+  std::size_t m_size = 0;
+  std::span<const SnapshotTableEntry> m_table;
+
+  const SnapshotTableEntry *find(SnapshotSection section) const;
+  void close();
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class Graph;
+
+// Uniform grid over node centres and edge bounding boxes, used to find the
+// primitives that intersect the camera view. Cells are stored CSR-style (one
+// offset array plus one item array per kind), so a rebuild is two counting
+// passes and a query touches only the cells under the view rectangle. Edges
+// whose box would cover more than GRAPH_CONFIG::MAX_EDGE_CELLS cells are kept
+// on a separate list and tested individually instead.
+//
+// While the layout animates, nodes drift away from where they were indexed.
+// Rather than rebuilding every frame, callers report how far nodes may have
+// moved with addDrift(); queries widen their area by the accumulated drift,
+// so results stay a superset of what is visible, and isStale() says when the
+// widening has grown large enough that a rebuild pays off.
+class SpatialIndex {
+public:
+  SpatialIndex() = default;
+
+  void build(const Graph &graph); // Also resets the drift
+
+  // Every node has moved at most `distance` since the last call
+  void addDrift(float distance) { m_drift += distance; }
+  float getDrift() const { return m_drift; }
+  bool isStale() const; // Drift past GRAPH_CONFIG::SPATIAL_MAX_DRIFT_CELLS
+
+  // Nodes whose disc may intersect `area` and edges (from < to) whose
+  // bounding box may intersect it, given the drift. Output vectors are
+  // cleared first.
+  void query(const sf::FloatRect &area, std::vector<int> &nodes,
+             std::vector<std::pair<int, int>> &edges) const;
+  void queryNodes(const sf::FloatRect &area, std::vector<int> &nodes) const;
+  // How many nodes queryNodes would return, from the cell offsets alone
+  std::size_t countNodes(const sf::FloatRect &area) const;
+  // Every stride-th node queryNodes would return, skipping the rest without
+  // touching them, so the cost is O(rows + result)
+  void sampleNodes(const sf::FloatRect &area, std::size_t stride,
+                   std::vector<int> &nodes) const;
+  void queryEdges(const sf::FloatRect &area,
+                  std::vector<std::pair<int, int>> &edges) const;
+
+  std::size_t getNodeCount() const { return m_nodeItems.size(); }
+  std::size_t getEdgeCount() const { return m_edges.size(); }
+
+private:
+  sf::Vector2f m_origin;
+  float m_cellSize = 1.0f;
+  int m_columns = 0;
+  int m_rows = 0;
+  float m_drift = 0.0f;
+
+  std::vector<std::uint32_t> m_nodeCellStart;
+  std::vector<int> m_nodeItems; // Node ids
+  std::vector<std::uint32_t> m_edgeCellStart;
+  std::vector<std::uint32_t> m_edgeItems; // Indices into m_edges
+
+  std::vector<std::pair<int, int>> m_edges;
+  std::vector<sf::FloatRect> m_edgeBounds;
+  std::vector<std::uint32_t> m_longEdges;
+
+  // An edge is listed in every cell its box covers; stamps dedupe a query
+  mutable std::vector<std::uint32_t> m_edgeStamps;
+  mutable std::uint32_t m_stamp = 0;
+
+  struct CellRange {
+    int column0, row0, column1, row1;
+  };
+  CellRange cellsCovering(const sf::FloatRect &area) const;
+  bool nodeCells(const sf::FloatRect &area, CellRange &range) const;
+  static bool intersects(const sf::FloatRect &a, const sf::FloatRect &b);
+  static sf::FloatRect grow(const sf::FloatRect &area, float pad);
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// LRU cache of fixed-size tiles mapped from one file with mmap. Each tile is
+// its own mapping at dataOffset + index * tileBytes, so at most `capacity`
+// tiles are resident in the address space at once and evicting one is a
+// single munmap (writable caches map MAP_SHARED, so dirty pages go back to
+// the file). tileBytes and dataOffset must be multiples of the page size;
+// open() refuses files that aren't.
+class TileCache {
+public:
+  TileCache(std::size_t tileBytes, std::uint64_t dataOffset,
+            std::size_t capacity);
+  ~TileCache();
+  TileCache(const TileCache &) = delete;
+  TileCache &operator=(const TileCache &) = delete;
+
+  bool open(const std::string &path, bool writable);
+  void close();
+
+  // Pointer to the tile's bytes, valid until `capacity` other tiles have
+  // been acquired. Returns nullptr if the tile can't be mapped.
+  std::uint8_t *acquire(std::uint64_t index);
+
+  std::size_t getLoads() const { return m_loads; } // Misses
+  std::size_t getHits() const { return m_hits; }
+
+  // The running kernel's page size, which mmap offsets must be multiples of
+  static std::size_t getPageSize();
+  static bool isPageAligned(std::uint64_t bytes) {
+    return bytes % getPageSize() == 0;
+  }
+
+private:
+  struct Entry {
+    std::uint64_t index;
+    std::uint8_t *data;
+  };
+
+  std::size_t m_tileBytes;
+  std::uint64_t m_dataOffset;
+  std::size_t m_capacity;
+  int m_fd = -1;
+  bool m_writable = false;
+
+  std::list<Entry> m_lru; // Most recently used first
+  std::unordered_map<std::uint64_t, std::list<Entry>::iterator> m_entries;
+  std::size_t m_loads = 0;
+  std::size_t m_hits = 0;
+
+  void evictOldest();
+};
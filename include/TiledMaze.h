@@ -0,0 +1,55 @@
+#pragma once
+#include "Config.h"
+#include <cstdint>
+#include <string>
+
+// On-disk maze made of fixed-size, bit-packed square tiles, for grids far
+// larger than RAM. Cell (x, y) lives in tile (x / side, y / side) at bit
+// (y % side) * side + (x % side); a set bit is an open cell. Tiles are
+// stored row-major after a one-page header, each tileBytes long and page
+// aligned, so a TileCache can map any one of them on its own. Cells of the
+// edge tiles that fall outside the maze are walls.
+//
+// TiledMaze only holds the geometry; traversals map tiles through their
+// own TileCache (see TiledMazeSolver).
+class TiledMaze {
+public:
+  // Writes a width x height maze to `path` one tile at a time, in file
+  // order, holding a single tile in memory. Rooms sit on even (x, y). Each
+  // tile is a perfect maze drawn from Philox(seed, tile index) plus one
+  // passage into its right and lower neighbour, so the whole maze is
+  // connected, and MAZE_CONFIG::LOOP_PERCENT of the remaining walls between
+  // rooms are knocked out to add loops.
+  static bool generate(const std::string &path, std::uint64_t width,
+                       std::uint64_t height, std::uint64_t seed,
+                       std::uint32_t tileSide = MAZE_CONFIG::TILE_SIDE);
+
+  bool open(const std::string &path);
+
+  const std::string &getPath() const { return m_path; }
+  std::uint64_t getWidth() const { return m_width; }
+  std::uint64_t getHeight() const { return m_height; }
+  std::uint32_t getTileSide() const { return m_tileSide; }
+  std::uint64_t getTilesAcross() const { return m_tilesAcross; }
+  std::uint64_t getTilesDown() const { return m_tilesDown; }
+  std::uint64_t getTileCount() const { return m_tilesAcross * m_tilesDown; }
+  std::uint64_t getTileBytes() const { return m_tileBytes; }
+  std::uint64_t getDataOffset() const { return m_dataOffset; }
+
+  static bool testCell(const std::uint8_t *tile, std::uint32_t local) {
+    return (tile[local >> 3] >> (local & 7)) & 1;
+  }
+  static void setCell(std::uint8_t *tile, std::uint32_t local) {
+    tile[local >> 3] |= static_cast<std::uint8_t>(1u << (local & 7));
+  }
+
+private:
+  std::string m_path;
+  std::uint64_t m_width = 0;
+  std::uint64_t m_height = 0;
+  std::uint32_t m_tileSide = 0;
+  std::uint64_t m_tilesAcross = 0;
+  std::uint64_t m_tilesDown = 0;
+  std::uint64_t m_tileBytes = 0;
+  std::uint64_t m_dataOffset = 0;
+};
@@ -0,0 +1,83 @@
+#pragma once
+#include "TileCache.h"
+#include "TiledMaze.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+struct MazeSolveResult {
+  bool reached = false;
+  std::uint64_t distance = 0; // Steps from source to target
+  std::uint64_t visited = 0;  // Cells settled before the target was found
+  std::uint64_t levels = 0;
+  std::uint64_t tileVisits = 0;  // Tiles processed, summed over levels
+  std::uint64_t spilled = 0;     // Frontier entries written to disk
+  std::uint64_t peakFrontier = 0; // Largest in-memory frontier, entries
+};
+
+// Level-synchronous BFS over a TiledMaze that never holds more than a few
+// tiles in memory. The frontier is bucketed by tile as local cell indices,
+// and each level walks the tiles that have work in ascending file order,
+// so both files are read front to back, once per level, through two
+// MAZE_CONFIG::CACHE_TILES-entry TileCaches: the read-only maze and a
+// sparse visited bitmap in a scratch directory next to the maze.
+//
+// Inside a tile, a neighbour is tested and marked at once. A neighbour in
+// another tile is never touched while this tile is loaded: it goes to that
+// tile's incoming list and is admitted (wall and visited test) when that
+// tile's turn comes in the next level. Incoming lists beyond
+// MAZE_CONFIG::FRONTIER_BUDGET_ENTRIES are spilled by appending them to a
+// per-tile, per-level file, which is read back sequentially with the tile
+// itself. The level is part of the name because a spill while level L is
+// expanding can target a tile whose level-L entries are still on disk.
+class TiledMazeSolver {
+public:
+  explicit TiledMazeSolver(const TiledMaze &maze);
+  ~TiledMazeSolver();
+
+  // Shortest path length between two cells; false on I/O errors or if
+  // either cell is outside the maze or a wall
+  bool solve(std::uint64_t sourceX, std::uint64_t sourceY,
+             std::uint64_t targetX, std::uint64_t targetY,
+             MazeSolveResult &result);
+
+  std::size_t getTileLoads() const {
+    return m_walls.getLoads() + m_visited.getLoads();
+  }
+
+private:
+  struct Bucket {
+    std::vector<std::uint32_t> admitted; // Marked visited already
+    std::vector<std::uint32_t> incoming; // From other tiles, untested
+    bool spilled = false;                // More incoming on disk
+  };
+  using Frontier = std::map<std::uint64_t, Bucket>; // By tile index
+
+  const TiledMaze &m_maze;
+  TileCache m_walls;
+  TileCache m_visited;
+  std::string m_scratchDir;
+
+  Frontier m_current;
+  Frontier m_next;
+  std::size_t m_buffered = 0; // Incoming entries held in m_next
+
+  std::uint64_t m_targetTile = 0;
+  std::uint32_t m_targetLocal = 0;
+
+  bool createScratch();
+  void removeScratch();
+  bool locate(std::uint64_t x, std::uint64_t y, std::uint64_t &tile,
+              std::uint32_t &local) const;
+
+  // Admits the tile's incoming cells and expands its level-`level` cells;
+  // sets result.reached once the target is settled
+  bool expandTile(std::uint64_t tile, Bucket &bucket, std::uint64_t level,
+                  MazeSolveResult &result);
+  // Incoming lists in m_next hold level-`level` cells
+  bool spillIncoming(std::uint64_t level, MazeSolveResult &result);
+  bool readSpill(std::uint64_t tile, std::uint64_t level,
+                 std::vector<std::uint32_t> &out);
+  std::string getSpillPath(std::uint64_t tile, std::uint64_t level) const;
+};
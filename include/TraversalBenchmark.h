@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+
+struct TraversalBenchmarkOptions {
+  int gridSide = 1000; // Traverses a gridSide x gridSide 4-connected grid
+  int repeats = 5;
+};
+
+// Headless comparison of BFSVisualizer::step(), driven by the coroutine
+// traversal engine, against a copy of the pre-engine step() (hash-set
+// visited tracking, hash-map node-state buffer, per-step clock reads). Both
+// traverse the same grid Graph from startBFS to the final node-state flush
+// and must agree on the visit order and per-level stats.
+//
+// runTurbo() drives a headless BFSVisualizer over a gridSide x gridSide
+// Graph in turbo mode, one simulated 60 Hz frame per update(), and reports
+// how many frames the traversal takes and the longest frame, checking that
+// every node was visited.
+//
+// runKernels() runs TraversalKernels::breadthFirstLevels on the same grid
+// through every graph backend, with 32- and 64-bit ids, and through
+// ErasedGraph (virtual dispatch) wrappers, checking that all level arrays
+// agree.
+class TraversalBenchmark {
+public:
+  explicit TraversalBenchmark(TraversalBenchmarkOptions options);
+  ~TraversalBenchmark() = default;
+
+  // Returns false if the two implementations disagree
+  bool run();
+  bool runKernels();
+  bool runTurbo();
+
+private:
+  TraversalBenchmarkOptions m_options;
+};
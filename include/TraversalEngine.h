@@ -0,0 +1,284 @@
+#pragma once
+#include "CompressedAdjacency.h"
+#include "Generator.h"
+#include "GraphConcept.h"
+#include "RadixHeap.h"
+#include "RingBuffer.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+enum class TraversalAlgorithm : std::uint8_t {
+  BFS,
+  ZERO_ONE_BFS,
+  DIJKSTRA,
+  A_STAR,
+};
+
+enum class TraversalEventType : std::uint8_t {
+  VISIT,    // node = node taken off the frontier, value = its level
+  DISCOVER, // node = newly reached node, value = parent
+  RELAX,    // node = frontier node whose distance dropped, value = parent
+  EXPANDED, // node = node just expanded, value = adjacency entries examined
+};
+
+// 12 bytes; yielded by value for every change a traversal makes
+struct TraversalEvent {
+  TraversalEventType type = TraversalEventType::EXPANDED;
+  int node = -1;
+  int value = 0;
+};
+
+// Traversal state that outlives a single step and is shared with the caller
+// for display. Per-node arrays are indexed by id: level is the hop count in
+// the current search tree and distance the (weighted) cost, both unreached
+// by default. queue is the FIFO of BFS and the deque of 0-1 BFS; heap is
+// the priority queue of Dijkstra and A*.
+struct TraversalContext {
+  static constexpr std::uint32_t UNREACHED =
+      std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<int> level;
+  std::vector<int> parent;
+  std::vector<std::uint32_t> distance;
+  std::vector<std::uint8_t> settled;
+  RingBuffer<int> queue;
+  RadixHeap<int> heap;
+
+  std::size_t frontier = 0; // Discovered but not yet settled
+  bool complete = false;    // Set before the final EXPANDED event
+
+  void reset(int vertexCount);
+  void grow(int vertexCount); // For ids added while a traversal runs
+};
+
+// Traversal algorithms written as straight-line coroutines. Each expansion
+// yields VISIT, then DISCOVER or RELAX per improved node, then EXPANDED;
+// the caller pulls events until EXPANDED to perform one step. Between steps
+// the coroutine is always suspended outside its neighbor loop, so the
+// adjacency may be replaced (graph edits) between steps; settled nodes are
+// not reopened.
+//
+// Every engine stops once `target` is settled (-1 = explore everything).
+// Passing RESUME as the start skips seeding and continues from whatever
+// frontier the context holds (a restored snapshot).
+//
+// The engines are written once against TraversableGraph (GraphConcept.h),
+// like TraversalKernels, and instantiated per backend. Weighted engines read
+// graph.weights(v) where the backend has it (a weighted CompressedAdjacency
+// snapshot) and fall back to unit costs otherwise. The context is indexed
+// by int, so a backend's ids must fit in one.
+class TraversalEngine {
+public:
+  static constexpr int RESUME = -1;
+
+  template <TraversableGraph G>
+  static Generator<TraversalEvent> breadthFirst(const G &graph,
+                                                TraversalContext &context,
+                                                int start, int target = -1);
+
+  // Edge weights must be 0 or 1; zero-cost edges go to the front of the
+  // deque
+  template <TraversableGraph G>
+  static Generator<TraversalEvent>
+  zeroOneBreadthFirst(const G &graph, TraversalContext &context, int start,
+                      int target = -1);
+
+  // Dijkstra when heuristic is null, A* otherwise. The heuristic (indexed by
+  // id) should be consistent so radix heap keys never decrease; keys that
+  // would fall below the last popped key are raised to it.
+  template <TraversableGraph G>
+  static Generator<TraversalEvent>
+  bestFirst(const G &graph, TraversalContext &context, int start,
+            int target = -1,
+            const std::vector<std::uint32_t> *heuristic = nullptr);
+
+  // The engine for `algorithm` over the visualizer's snapshot
+  static Generator<TraversalEvent>
+  create(TraversalAlgorithm algorithm, const CompressedAdjacency &adjacency,
+        TraversalContext &context, int start, int target,
+        const std::vector<std::uint32_t> *heuristic);
+
+  static const char *getName(TraversalAlgorithm algorithm);
+  static EdgeWeights getEdgeWeights(TraversalAlgorithm algorithm);
+  static bool usesQueue(TraversalAlgorithm algorithm); // vs. the heap
+  static TraversalAlgorithm next(TraversalAlgorithm algorithm);
+
+private:
+  // Weights of vertex's edges in neighbor order; nullptr for unit costs
+  template <TraversableGraph G>
+  static const std::uint32_t *getWeights(const G &graph, int vertex) {
+    using Id = typename G::VertexId;
+    if constexpr (requires { graph.weights(Id{}); }) {
+      return graph.weights(static_cast<Id>(vertex));
+    } else {
+      return nullptr;
+    }
+  }
+};
+
+template <TraversableGraph G>
+Generator<TraversalEvent>
+TraversalEngine::breadthFirst(const G &graph, TraversalContext &context,
+                              int start, int target) {
+  using Id = typename G::VertexId;
+  if (start != RESUME) {
+    context.grow(start + 1);
+    context.level[start] = 0;
+    context.distance[start] = 0;
+    context.queue.push_back(start);
+    context.frontier = 1;
+    co_yield {TraversalEventType::DISCOVER, start, -1};
+  }
+
+  while (!context.queue.empty()) {
+    int current = context.queue.front();
+    context.queue.pop_front();
+    context.settled[current] = 1;
+    --context.frontier;
+    co_yield {TraversalEventType::VISIT, current, context.level[current]};
+
+    int examined = 0;
+    for (auto id : graph.neighbors(static_cast<Id>(current))) {
+      const int neighborId = static_cast<int>(id);
+      ++examined;
+      if (context.level[neighborId] == -1) {
+        context.level[neighborId] = context.level[current] + 1;
+        context.distance[neighborId] = context.distance[current] + 1;
+        context.parent[neighborId] = current;
+        context.queue.push_back(neighborId);
+        ++context.frontier;
+        co_yield {TraversalEventType::DISCOVER, neighborId, current};
+      }
+    }
+
+    context.complete = context.queue.empty() || current == target;
+    co_yield {TraversalEventType::EXPANDED, current, examined};
+    if (current == target)
+      co_return;
+  }
+}
+
+template <TraversableGraph G>
+Generator<TraversalEvent>
+TraversalEngine::zeroOneBreadthFirst(const G &graph, TraversalContext &context,
+                                     int start, int target) {
+  using Id = typename G::VertexId;
+  if (start != RESUME) {
+    context.grow(start + 1);
+    context.level[start] = 0;
+    context.distance[start] = 0;
+    context.queue.push_back(start);
+    context.frontier = 1;
+    co_yield {TraversalEventType::DISCOVER, start, -1};
+  }
+
+  while (!context.queue.empty()) {
+    int current = context.queue.front();
+    context.queue.pop_front();
+
+    // A node can be queued once per improvement; only the first pop counts
+    if (context.settled[current])
+      continue;
+    context.settled[current] = 1;
+    --context.frontier;
+    co_yield {TraversalEventType::VISIT, current, context.level[current]};
+
+    const std::uint32_t *weights = getWeights(graph, current);
+    int examined = 0;
+    for (auto id : graph.neighbors(static_cast<Id>(current))) {
+      const int neighborId = static_cast<int>(id);
+      std::uint32_t weight = weights ? weights[examined] : 1;
+      ++examined;
+      std::uint32_t candidate = context.distance[current] + weight;
+      if (context.settled[neighborId] ||
+          candidate >= context.distance[neighborId])
+        continue;
+
+      bool firstReach = context.distance[neighborId] ==
+                        TraversalContext::UNREACHED;
+      context.distance[neighborId] = candidate;
+      context.level[neighborId] = context.level[current] + 1;
+      context.parent[neighborId] = current;
+      if (weight == 0) {
+        context.queue.push_front(neighborId);
+      } else {
+        context.queue.push_back(neighborId);
+      }
+      if (firstReach)
+        ++context.frontier;
+      co_yield {firstReach ? TraversalEventType::DISCOVER
+                           : TraversalEventType::RELAX,
+                neighborId, current};
+    }
+
+    context.complete = context.frontier == 0 || current == target;
+    co_yield {TraversalEventType::EXPANDED, current, examined};
+    if (current == target)
+      co_return;
+  }
+}
+
+template <TraversableGraph G>
+Generator<TraversalEvent> TraversalEngine::bestFirst(
+    const G &graph, TraversalContext &context, int start, int target,
+    const std::vector<std::uint32_t> *heuristic) {
+  using Id = typename G::VertexId;
+  auto estimate = [heuristic](int id) -> std::uint32_t {
+    return heuristic ? (*heuristic)[id] : 0;
+  };
+
+  if (start != RESUME) {
+    context.grow(start + 1);
+    context.level[start] = 0;
+    context.distance[start] = 0;
+    context.heap.push(estimate(start), start);
+    context.frontier = 1;
+    co_yield {TraversalEventType::DISCOVER, start, -1};
+  }
+
+  while (!context.heap.empty()) {
+    int current = context.heap.pop().second;
+
+    // Entries superseded by a later decrease are skipped lazily
+    if (context.settled[current])
+      continue;
+    context.settled[current] = 1;
+    --context.frontier;
+    co_yield {TraversalEventType::VISIT, current, context.level[current]};
+
+    const std::uint32_t *weights = getWeights(graph, current);
+    int examined = 0;
+    for (auto id : graph.neighbors(static_cast<Id>(current))) {
+      const int neighborId = static_cast<int>(id);
+      std::uint32_t weight = weights ? weights[examined] : 1;
+      ++examined;
+      std::uint32_t candidate = context.distance[current] + weight;
+      if (context.settled[neighborId] ||
+          candidate >= context.distance[neighborId])
+        continue;
+
+      bool firstReach = context.distance[neighborId] ==
+                        TraversalContext::UNREACHED;
+      context.distance[neighborId] = candidate;
+      context.level[neighborId] = context.level[current] + 1;
+      context.parent[neighborId] = current;
+      // An estimate gone stale under graph edits can undercut the key just
+      // popped; raising it keeps the heap ordered at the cost of optimality
+      context.heap.push(
+          std::max(candidate + estimate(neighborId), context.heap.getLast()),
+          neighborId);
+      if (firstReach)
+        ++context.frontier;
+      co_yield {firstReach ? TraversalEventType::DISCOVER
+                           : TraversalEventType::RELAX,
+                neighborId, current};
+    }
+
+    context.complete = context.frontier == 0 || current == target;
+    co_yield {TraversalEventType::EXPANDED, current, examined};
+    if (current == target)
+      co_return;
+  }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "GraphConcept.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Whole-graph traversals written once against TraversableGraph and
+// instantiated per backend (CompressedAdjacency, CsrGraph, GridGraph, ...).
+// The neighbor range of each backend inlines into the loop, so a CSR
+// instantiation is a straight scan over a span and a grid instantiation
+// computes neighbors in registers; ErasedGraph instantiates the same code
+// behind a virtual call for comparison.
+class TraversalKernels {
+public:
+  static constexpr std::int32_t UNREACHED = -1;
+
+  // Hop distance from source to every vertex (UNREACHED where none) and the
+  // number of vertices reached. `queue` is scratch space, reused by the
+  // caller across runs; it is a flat array since each vertex enters once.
+  template <TraversableGraph G>
+  static std::size_t
+  breadthFirstLevels(const G &graph, typename G::VertexId source,
+                     std::vector<std::int32_t> &level,
+                     std::vector<typename G::VertexId> &queue) {
+    using Id = typename G::VertexId;
+    const std::size_t count = graph.getVertexCount();
+    level.assign(count, UNREACHED);
+    queue.resize(count);
+
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    level[source] = 0;
+    queue[tail++] = source;
+    while (head < tail) {
+      const Id current = queue[head++];
+      const std::int32_t next = level[current] + 1;
+      for (auto neighborId : graph.neighbors(current)) {
+        if (level[neighborId] == UNREACHED) {
+          level[neighborId] = next;
+          queue[tail++] = static_cast<Id>(neighborId);
+        }
+      }
+    }
+    return tail;
+  }
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Work done while expanding one BFS level
+struct LevelStats {
+  int level = 0;
+  size_t frontierSize = 0;  // Nodes expanded at this level
+  size_t edgesExamined = 0; // Adjacency entries scanned while expanding them
+  size_t discovered = 0;    // Nodes they added to the next level
+  double micros = 0.0;      // Time spent inside those expansions
+};
+
+// Per-level metrics recorded as a traversal runs, with CSV/JSON export for
+// offline analysis of how frontier shape drives traversal cost. Expansions
+// are recorded untimed; the caller times whole batches of steps and hands
+// the elapsed time to addElapsed, which splits it evenly across the
+// expansions recorded since the previous call.
+class TraversalStats {
+public:
+  TraversalStats() = default;
+  ~TraversalStats() = default;
+
+  void clear();
+
+  // Replace every level (snapshot restore); totals are recomputed
+  void restore(std::vector<LevelStats> levels);
+
+  // One expanded node at `level`
+  void recordExpansion(int level, size_t edgesExamined, size_t discovered);
+
+  // Time taken by the expansions recorded since the last call
+  void addElapsed(double micros);
+
+  const std::vector<LevelStats> &getLevels() const { return m_levels; }
+  size_t getLargestFrontier() const { return m_largestFrontier; }
+  size_t getTotalExpanded() const { return m_totalExpanded; }
+  size_t getTotalEdges() const { return m_totalEdges; }
+  double getTotalMicros() const { return m_totalMicros; }
+
+  bool exportCsv(const std::string &path) const;
+  bool exportJson(const std::string &path) const;
+
+private:
+  std::vector<LevelStats> m_levels; // Index = level
+  size_t m_largestFrontier = 0;
+  size_t m_totalExpanded = 0;
+  size_t m_totalEdges = 0;
+  double m_totalMicros = 0.0;
+
+  // Expansions not yet timed, as (level, count) runs in recording order
+  std::vector<std::pair<int, size_t>> m_untimed;
+  size_t m_untimedCount = 0;
+};
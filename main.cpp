@@ -1,10 +1,178 @@
 #include "Application.h"
+#include "BatchGenerator.h"
+#include "ComponentsBenchmark.h"
+#include "CullingBenchmark.h"
+#include "QueryServer.h"
+#include "ServerBenchmark.h"
+#include "TiledMaze.h"
+#include "TiledMazeSolver.h"
+#include "TraversalBenchmark.h"
+#include <cstring>
 #include <exception>
 #include <iostream>
+#include <random>
+#include <string>
 
-int main() {
+static void printUsage(const char *program) {
+  std::cerr << "Usage: " << program
+            << " [--seed S] [--graph FILE] [--snapshot FILE]\n"
+            << "       " << program
+            << " --batch COUNT [--seed S] [--out DIR] [--threads N]\n"
+            << "       " << program << " --bench-traversal [GRID_SIDE]\n"
+            << "       " << program
+            << " --bench-components [GRID_SIDE] [--threads N]\n"
+            << "       " << program << " --bench-kernels [GRID_SIDE]\n"
+            << "       " << program << " --bench-culling [GRAPHS] [--seed S]\n"
+            << "       " << program << " --bench-turbo [GRID_SIDE]\n"
+            << "       " << program << " --bench-server [VERTICES] [--seed S]\n"
+            << "       " << program
+            << " --serve SOCKET [--graph FILE | --seed S]\n"
+            << "       " << program
+            << " --maze-gen FILE WIDTH HEIGHT [--seed S] [--tile-side N]\n"
+            << "       " << program << " --maze-solve FILE\n";
+}
+
+int main(int argc, char *argv[]) {
   try {
-    Application app;
+    std::uint64_t seed = std::random_device{}();
+    std::string graphPath;
+    BatchOptions batch;
+    bool batchMode = false;
+    TraversalBenchmarkOptions bench;
+    ComponentsBenchmarkOptions componentsBench;
+    bool benchMode = false;
+    bool componentsMode = false;
+    bool cullingMode = false;
+    int cullingGraphs = CullingBenchmarkOptions{}.graphs;
+    bool serverBenchMode = false;
+    int serverBenchVertices = ServerBenchmarkOptions{}.vertices;
+    bool kernelsMode = false;
+    bool turboMode = false;
+    std::string socketPath;
+    std::string snapshotPath;
+    std::string mazeGenPath;
+    std::string mazeSolvePath;
+    std::uint64_t mazeWidth = 0;
+    std::uint64_t mazeHeight = 0;
+    std::uint32_t tileSide = MAZE_CONFIG::TILE_SIDE;
+
+    for (int i = 1; i < argc; ++i) {
+      bool hasValue = i + 1 < argc;
+      if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+        seed = std::stoull(argv[++i]);
+      } else if (std::strcmp(argv[i], "--graph") == 0 && hasValue) {
+        graphPath = argv[++i];
+      } else if (std::strcmp(argv[i], "--batch") == 0 && hasValue) {
+        batchMode = true;
+        batch.count = std::stoull(argv[++i]);
+      } else if (std::strcmp(argv[i], "--out") == 0 && hasValue) {
+        batch.outputDir = argv[++i];
+      } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+        batch.threads = static_cast<unsigned int>(std::stoul(argv[++i]));
+        componentsBench.threads = batch.threads;
+      } else if (std::strcmp(argv[i], "--snapshot") == 0 && hasValue) {
+        snapshotPath = argv[++i];
+      } else if (std::strcmp(argv[i], "--serve") == 0 && hasValue) {
+        socketPath = argv[++i];
+      } else if (std::strcmp(argv[i], "--maze-gen") == 0 && i + 3 < argc) {
+        mazeGenPath = argv[++i];
+        mazeWidth = std::stoull(argv[++i]);
+        mazeHeight = std::stoull(argv[++i]);
+      } else if (std::strcmp(argv[i], "--maze-solve") == 0 && hasValue) {
+        mazeSolvePath = argv[++i];
+      } else if (std::strcmp(argv[i], "--tile-side") == 0 && hasValue) {
+        tileSide = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+      } else if (std::strcmp(argv[i], "--bench-components") == 0) {
+        componentsMode = true;
+        if (hasValue && argv[i + 1][0] != '-') {
+          componentsBench.gridSide = std::stoi(argv[++i]);
+        }
+      } else if (std::strcmp(argv[i], "--bench-culling") == 0) {
+        cullingMode = true;
+        if (hasValue && argv[i + 1][0] != '-') {
+          cullingGraphs = std::stoi(argv[++i]);
+        }
+      } else if (std::strcmp(argv[i], "--bench-server") == 0) {
+        serverBenchMode = true;
+        if (hasValue && argv[i + 1][0] != '-') {
+          serverBenchVertices = std::stoi(argv[++i]);
+        }
+      } else if (std::strcmp(argv[i], "--bench-traversal") == 0 ||
+                 std::strcmp(argv[i], "--bench-kernels") == 0 ||
+                 std::strcmp(argv[i], "--bench-turbo") == 0) {
+        benchMode = true;
+        kernelsMode = std::strcmp(argv[i], "--bench-kernels") == 0;
+        turboMode = std::strcmp(argv[i], "--bench-turbo") == 0;
+        if (hasValue && argv[i + 1][0] != '-') {
+          bench.gridSide = std::stoi(argv[++i]);
+        }
+      } else {
+        printUsage(argv[0]);
+        return -1;
+      }
+    }
+
+    if (cullingMode) {
+      CullingBenchmarkOptions culling;
+      culling.graphs = cullingGraphs;
+      culling.seed = seed;
+      CullingBenchmark benchmark(culling);
+      return benchmark.run() ? 0 : -1;
+    }
+
+    if (serverBenchMode) {
+      ServerBenchmarkOptions serving;
+      serving.vertices = serverBenchVertices;
+      serving.seed = seed;
+      ServerBenchmark benchmark(serving);
+      return benchmark.run() ? 0 : -1;
+    }
+
+    if (componentsMode) {
+      ComponentsBenchmark benchmark(componentsBench);
+      return benchmark.run() ? 0 : -1;
+    }
+
+    if (benchMode) {
+      TraversalBenchmark benchmark(bench);
+      bool ok = kernelsMode ? benchmark.runKernels()
+                : turboMode ? benchmark.runTurbo()
+                            : benchmark.run();
+      return ok ? 0 : -1;
+    }
+
+    if (!mazeGenPath.empty()) {
+      return TiledMaze::generate(mazeGenPath, mazeWidth, mazeHeight, seed,
+                                 tileSide)
+                 ? 0
+                 : -1;
+    }
+
+    if (!mazeSolvePath.empty()) {
+      // Corner to corner: the top-left room to the bottom-right-most one
+      TiledMaze maze;
+      if (!maze.open(mazeSolvePath))
+        return -1;
+      TiledMazeSolver solver(maze);
+      MazeSolveResult result;
+      return solver.solve(0, 0, (maze.getWidth() - 1) & ~std::uint64_t{1},
+                          (maze.getHeight() - 1) & ~std::uint64_t{1}, result)
+                 ? 0
+                 : -1;
+    }
+
+    if (!socketPath.empty()) {
+      QueryServer server({socketPath, graphPath, seed});
+      return server.run() ? 0 : -1;
+    }
+
+    if (batchMode) {
+      batch.seed = seed;
+      BatchGenerator generator(batch);
+      return generator.run() ? 0 : -1;
+    }
+
+    Application app(seed, graphPath, snapshotPath);
     app.run();
   } catch (const std::exception &e) {
     std::cerr << "Error: " << e.what() << std::endl;
@@ -1,17 +1,55 @@
 #include "Application.h"
 #include "Config.h"
+#include "Snapshot.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
 #include <iostream>
+#include <sstream>
 
-Application::Application()
+namespace {
+// Pastel hue per component, stepped by the golden angle so consecutive
+// component numbers get clearly different colours
+sf::Color componentColor(int component) {
+  const float hue = std::fmod(component * 137.508f, 360.0f) / 60.0f;
+  const float value = COLOR_CONFIG::COMPONENT_VALUE;
+  const float chroma = value * COLOR_CONFIG::COMPONENT_SATURATION;
+  const float x = chroma * (1.0f - std::fabs(std::fmod(hue, 2.0f) - 1.0f));
+
+  float rgb[3] = {0.0f, 0.0f, 0.0f};
+  const int sector = static_cast<int>(hue) % 6;
+  const int major[6] = {0, 1, 1, 2, 2, 0}; // Channel that gets chroma
+  const int minor[6] = {1, 0, 2, 1, 0, 2}; // Channel that gets x
+  rgb[major[sector]] = chroma;
+  rgb[minor[sector]] = x;
+
+  auto channel = [&](float c) {
+    return static_cast<std::uint8_t>((c + value - chroma) * 255.0f);
+  };
+  return sf::Color(channel(rgb[0]), channel(rgb[1]), channel(rgb[2]));
+}
+} // namespace
+
+Application::Application(std::uint64_t seed, std::string graphPath,
+                         std::string snapshotPath)
     : m_window(sf::VideoMode({WINDOW_CONFIG::WIDTH, WINDOW_CONFIG::HEIGHT}),
-               WINDOW_CONFIG::TITLE, sf::Style::Titlebar | sf::Style::Close) {
+               WINDOW_CONFIG::TITLE, sf::Style::Titlebar | sf::Style::Close),
+      m_seed(seed), m_snapshotPath(snapshotPath.empty()
+                                       ? GRAPH_CONFIG::SNAPSHOT_PATH
+                                       : snapshotPath) {
   m_window.setFramerateLimit(60);
+  resetCamera();
 
   if (!loadResources()) {
     throw std::runtime_error("Failed to load resources");
   }
 
-  initializeGraph();
+  initializeGraph(graphPath, !snapshotPath.empty());
+}
+
+Application::~Application() {
+  // Let an in-flight job bail out early instead of blocking shutdown
+  cancelGraphGeneration();
 }
 
 void Application::run() {
@@ -20,7 +58,42 @@ void Application::run() {
 
     handleEvents();
     update(deltaTime);
-    render();
+
+    // Unchanged frames are not redrawn
+    if (m_needsRedraw) {
+      render();
+      m_needsRedraw = false;
+    }
+    waitForWork();
+  }
+}
+
+void Application::waitForWork() {
+  // Anything animating: keep looping, display() paces to the frame limit
+  const bool animating =
+      m_panning || (m_layout->isEnabled() && !m_layout->isSettled()) ||
+      m_visualizer->getTimeToNextStep() == 0.0f;
+  if (animating)
+    return;
+
+  // Otherwise sleep in waitEvent until input arrives or the next scheduled
+  // thing is due: an auto-step, or polling a background job. A pending
+  // raster is polled too (SFML cannot wake waitEvent from a worker), but
+  // the wake-up only redraws if the raster has finished.
+  float timeout = m_visualizer->getTimeToNextStep();
+  if (isGenerating() || m_renderer.isRasterPending() ||
+      m_pendingSnapshot.valid() || m_pendingComponents.valid()) {
+    timeout = std::min(timeout, WINDOW_CONFIG::BACKGROUND_POLL_SECONDS);
+  }
+
+  if (timeout <= 0.0f)
+    return;
+
+  // waitEvent treats a zero Time as "no timeout"
+  const sf::Time wait =
+      std::isinf(timeout) ? sf::Time::Zero : sf::seconds(timeout);
+  if (const auto event = m_window.waitEvent(wait)) {
+    handleEvent(*event);
   }
 }
 
@@ -34,34 +107,180 @@ bool Application::loadResources() {
   return true;
 }
 
-void Application::initializeGraph() {
+void Application::initializeGraph(const std::string &graphPath,
+                                  bool resumeSnapshot) {
   m_graph = std::make_unique<Graph>();
   m_visualizer = std::make_unique<BFSVisualizer>(*m_graph);
+  m_layout = std::make_unique<ForceLayout>(*m_graph);
+
+  // Resume the saved session rather than starting a new one. Only on
+  // request: a default snapshot left by an earlier run is for F9.
+  if (resumeSnapshot && std::filesystem::exists(m_snapshotPath) &&
+      restoreSnapshot())
+    return;
+
+  if (!graphPath.empty()) {
+    if (!m_graph->loadFromFile(graphPath)) {
+      throw std::runtime_error("Failed to load graph: " + graphPath);
+    }
+    return;
+  }
 
   // Generate initial sample graph
-  m_graph->generateSampleGraph();
+  startGraphGeneration();
+}
+
+void Application::startGraphGeneration() {
+  // Only one job runs at a time; a previously cancelled job exits at its
+  // next cancellation check, so this wait is short
+  if (m_pendingGraph.valid()) {
+    m_pendingGraph.wait();
+  }
+
+  std::uint64_t seed = m_seed;
+  std::uint64_t stream = m_nextStream++;
+  std::cout << "Generating graph (seed " << seed << ", index " << stream
+            << ")\n";
+
+  auto progress = std::make_shared<GenerationProgress>();
+  m_generationProgress = progress;
+  m_pendingGraph = std::async(std::launch::async, [progress, seed, stream]() {
+    auto graph = std::make_unique<Graph>();
+    if (!graph->generateSampleGraph(seed, stream, progress.get())) {
+      return std::unique_ptr<Graph>();
+    }
+    return graph;
+  });
+}
+
+void Application::cancelGraphGeneration() {
+  if (m_generationProgress) {
+    m_generationProgress->cancelled.store(true, std::memory_order_relaxed);
+  }
+}
+
+void Application::pollGraphGeneration() {
+  if (!isGenerating() || m_pendingGraph.wait_for(std::chrono::seconds(0)) !=
+                             std::future_status::ready) {
+    return;
+  }
+
+  std::unique_ptr<Graph> graph = m_pendingGraph.get();
+  bool cancelled = m_generationProgress->cancelled.load();
+  m_generationProgress.reset();
+
+  if (!graph || cancelled) {
+    std::cout << "Graph generation cancelled\n";
+    return;
+  }
+
+  // Swap the finished graph in on the UI thread so the visualizer never
+  // observes a half-built graph
+  selectNode(-1);
+  *m_graph = std::move(*graph);
+  m_visualizer->reset();
+  m_layout->restart();
+  markGraphChanged();
+}
+
+void Application::reorderGraph() {
+  selectNode(-1); // Ids are about to change
+  m_visualizer->reset();
+  ReorderReport report = GraphReorder::apply(*m_graph, m_nextReorder);
+
+  std::cout << "Reordered by " << GraphReorder::getName(report.strategy)
+            << ": bandwidth " << report.before.bandwidth << " -> "
+            << report.after.bandwidth << ", average gap "
+            << report.before.averageGap << " -> " << report.after.averageGap
+            << ", adjacency " << report.before.adjacencyBytes / 1024
+            << " -> " << report.after.adjacencyBytes / 1024
+            << " KiB, full BFS " << report.before.bfsMicros << " -> "
+            << report.after.bfsMicros << " us\n";
+
+  markGraphChanged();
+
+  switch (m_nextReorder) {
+  case ReorderStrategy::REVERSE_CUTHILL_MCKEE:
+    m_nextReorder = ReorderStrategy::BFS_ORDER;
+    break;
+  case ReorderStrategy::BFS_ORDER:
+    m_nextReorder = ReorderStrategy::HILBERT_CURVE;
+    break;
+  case ReorderStrategy::HILBERT_CURVE:
+    m_nextReorder = ReorderStrategy::REVERSE_CUTHILL_MCKEE;
+    break;
+  }
 }
 
 void Application::handleEvents() {
   while (const auto event = m_window.pollEvent()) {
-    if (event->is<sf::Event::Closed>()) {
-      m_window.close();
+    handleEvent(*event);
+  }
+}
+
+void Application::handleEvent(const sf::Event &event) {
+  // Hover alone changes nothing on screen
+  if (!event.is<sf::Event::MouseMoved>() || m_panning) {
+    m_needsRedraw = true;
+  }
+
+  if (event.is<sf::Event::Closed>()) {
+    m_window.close();
+  }
+
+  else if (const auto *keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+    handleKeyPressed(keyPressed->code);
+  }
+
+  else if (const auto *mouseButtonPressed =
+               event.getIf<sf::Event::MouseButtonPressed>()) {
+    if (mouseButtonPressed->button == sf::Mouse::Button::Left) {
+      // Clicks are resolved in graph space through the camera
+      handleMousePressed(
+          m_window.mapPixelToCoords(mouseButtonPressed->position, m_camera));
+    } else if (mouseButtonPressed->button == sf::Mouse::Button::Right) {
+      m_panning = true;
+      m_panAnchor = mouseButtonPressed->position;
     }
+  }
 
-    else if (const auto *keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-      handleKeyPressed(keyPressed->code);
+  else if (const auto *mouseButtonReleased =
+               event.getIf<sf::Event::MouseButtonReleased>()) {
+    if (mouseButtonReleased->button == sf::Mouse::Button::Right) {
+      m_panning = false;
     }
+  }
 
-    else if (const auto *mouseButtonPressed =
-                 event->getIf<sf::Event::MouseButtonPressed>()) {
-      if (mouseButtonPressed->button == sf::Mouse::Button::Left) {
-        sf::Vector2f mousePos(
-            static_cast<float>(mouseButtonPressed->position.x),
-            static_cast<float>(mouseButtonPressed->position.y));
-        handleMousePressed(mousePos);
-      }
+  else if (const auto *mouseMoved = event.getIf<sf::Event::MouseMoved>()) {
+    if (m_panning) {
+      // Keep the graph point under the anchor pixel under the cursor
+      const sf::Vector2i pixel = mouseMoved->position;
+      m_camera.move(m_window.mapPixelToCoords(m_panAnchor, m_camera) -
+                    m_window.mapPixelToCoords(pixel, m_camera));
+      m_panAnchor = pixel;
     }
   }
+
+  else if (const auto *wheel = event.getIf<sf::Event::MouseWheelScrolled>()) {
+    zoomCamera(wheel->delta, wheel->position);
+  }
+}
+
+void Application::zoomCamera(float delta, sf::Vector2i pixel) {
+  // Zoom about the cursor: the graph point under it stays put
+  const sf::Vector2f before = m_window.mapPixelToCoords(pixel, m_camera);
+  const float current = m_camera.getSize().x / WINDOW_CONFIG::WIDTH;
+  const float target =
+      std::clamp(current * std::pow(CAMERA_CONFIG::ZOOM_STEP, -delta),
+                 CAMERA_CONFIG::MIN_ZOOM, CAMERA_CONFIG::MAX_ZOOM);
+  m_camera.zoom(target / current);
+  m_camera.move(before - m_window.mapPixelToCoords(pixel, m_camera));
+}
+
+void Application::resetCamera() {
+  m_camera = sf::View(sf::FloatRect(
+      {0.0f, 0.0f}, {static_cast<float>(WINDOW_CONFIG::WIDTH),
+                     static_cast<float>(WINDOW_CONFIG::HEIGHT)}));
 }
 
 void Application::handleKeyPressed(sf::Keyboard::Key key) {
@@ -85,9 +304,98 @@ void Application::handleKeyPressed(sf::Keyboard::Key key) {
     m_visualizer->setAutoStep(!m_visualizer->isAutoStepping());
     break;
 
+  case sf::Keyboard::Key::T:
+    // Turbo implies auto-stepping
+    m_visualizer->setTurbo(!m_visualizer->isTurbo());
+    if (m_visualizer->isTurbo()) {
+      m_visualizer->setAutoStep(true);
+    }
+    break;
+
   case sf::Keyboard::Key::G:
-    m_visualizer->reset();
-    m_graph->generateSampleGraph();
+    // Pressing G while a graph is being generated aborts that job
+    if (isGenerating()) {
+      cancelGraphGeneration();
+    } else {
+      startGraphGeneration();
+    }
+    break;
+
+  case sf::Keyboard::Key::E:
+    m_editMode = !m_editMode;
+    selectNode(-1);
+    break;
+
+  case sf::Keyboard::Key::Delete:
+  case sf::Keyboard::Key::Backspace:
+    if (m_editMode) {
+      removeSelectedNode();
+    }
+    break;
+
+  // Queue display scrolling
+  case sf::Keyboard::Key::Left:
+    m_visualizer->scrollQueue(-1);
+    break;
+  case sf::Keyboard::Key::Right:
+    m_visualizer->scrollQueue(1);
+    break;
+  case sf::Keyboard::Key::PageUp:
+    m_visualizer->scrollQueue(-UI_CONFIG::QUEUE_SCROLL_PAGE);
+    break;
+  case sf::Keyboard::Key::PageDown:
+    m_visualizer->scrollQueue(UI_CONFIG::QUEUE_SCROLL_PAGE);
+    break;
+  case sf::Keyboard::Key::Home:
+    m_visualizer->scrollQueueToFront();
+    break;
+  case sf::Keyboard::Key::End:
+    m_visualizer->scrollQueueToBack();
+    break;
+
+  case sf::Keyboard::Key::L:
+    m_layout->setEnabled(!m_layout->isEnabled());
+    break;
+
+  case sf::Keyboard::Key::X:
+    if (m_visualizer->getStats().exportCsv("bfs_stats.csv") &&
+        m_visualizer->getStats().exportJson("bfs_stats.json")) {
+      std::cout << "Exported traversal stats to bfs_stats.csv and "
+                   "bfs_stats.json\n";
+    }
+    break;
+
+  case sf::Keyboard::Key::O:
+    reorderGraph();
+    break;
+
+  case sf::Keyboard::Key::C:
+    m_showComponents = !m_showComponents;
+    if (m_showComponents) {
+      m_componentsDirty = true;
+    } else {
+      clearComponentColors();
+    }
+    break;
+
+  case sf::Keyboard::Key::Num0:
+    resetCamera();
+    break;
+
+  case sf::Keyboard::Key::M:
+    m_visualizer->setAlgorithm(
+        TraversalEngine::next(m_visualizer->getAlgorithm()));
+    std::cout << "Algorithm: "
+              << TraversalEngine::getName(m_visualizer->getAlgorithm())
+              << "\n";
+    break;
+
+  case sf::Keyboard::Key::F5:
+    saveSnapshot();
+    break;
+
+  case sf::Keyboard::Key::F9:
+    restoreSnapshot();
     break;
 
   case sf::Keyboard::Key::P:
@@ -104,26 +412,380 @@ void Application::handleKeyPressed(sf::Keyboard::Key key) {
 }
 
 void Application::handleMousePressed(sf::Vector2f mousePos) {
+  if (m_editMode) {
+    handleEditClick(mousePos);
+    return;
+  }
+
   int nodeId = m_graph->getNodeAtPosition(mousePos);
-  if (nodeId != -1) {
-    if (m_visualizer->getState() == BFSState::READY) {
-      m_visualizer->startBFS(nodeId);
-      std::cout << "Started BFS from node " << nodeId << "\n";
+  if (nodeId == -1)
+    return;
+
+  // Shift+click picks the target the next traversal stops at
+  if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LShift) ||
+      sf::Keyboard::isKeyPressed(sf::Keyboard::Key::RShift)) {
+    m_visualizer->toggleTarget(nodeId);
+    return;
+  }
+
+  if (m_visualizer->getState() == BFSState::READY) {
+    m_visualizer->startBFS(nodeId);
+    std::cout << "Started "
+              << TraversalEngine::getName(m_visualizer->getAlgorithm())
+              << " from node " << m_graph->getLabel(nodeId) << "\n";
+  }
+}
+
+void Application::handleEditClick(sf::Vector2f mousePos) {
+  int nodeId = m_graph->getNodeAtPosition(mousePos);
+
+  if (nodeId == -1) {
+    // Empty space: drop a new, unconnected node there
+    int newId = m_graph->getNextId();
+    m_graph->addNode(newId, m_graph->clampToBounds(mousePos));
+    selectNode(-1);
+    markGraphChanged();
+    return;
+  }
+
+  if (m_selectedNode == -1) {
+    selectNode(nodeId);
+  } else if (m_selectedNode == nodeId) {
+    selectNode(-1);
+  } else {
+    bool added = !m_graph->hasEdge(m_selectedNode, nodeId);
+    if (added) {
+      m_graph->addEdge(m_selectedNode, nodeId);
+    } else {
+      m_graph->removeEdge(m_selectedNode, nodeId);
+    }
+    m_visualizer->onEdgeToggled(m_selectedNode, nodeId, added);
+    selectNode(-1);
+    markGraphChanged();
+  }
+}
+
+void Application::selectNode(int nodeId) {
+  if (auto previous = m_graph->getNode(m_selectedNode)) {
+    previous->setSelected(false);
+  }
+  m_selectedNode = nodeId;
+  if (auto node = m_graph->getNode(nodeId)) {
+    node->setSelected(true);
+  }
+}
+
+void Application::removeSelectedNode() {
+  if (m_selectedNode == -1)
+    return;
+
+  int nodeId = m_selectedNode;
+  selectNode(-1);
+
+  // Removing the traversal's own start node leaves nothing to repair
+  if (nodeId == m_visualizer->getDistances().getSource()) {
+    m_visualizer->reset();
+  }
+
+  // Detach edge by edge so the distance tree is repaired for each removal,
+  // then drop the isolated node
+  std::vector<int> neighbors = m_graph->getNode(nodeId)->getNeighbors();
+  for (int neighborId : neighbors) {
+    m_graph->removeEdge(nodeId, neighborId);
+    m_visualizer->onEdgeToggled(nodeId, neighborId, false);
+  }
+  m_graph->removeNode(nodeId);
+  markGraphChanged();
+}
+
+void Application::saveSnapshot() {
+  if (m_pendingSnapshot.valid()) {
+    std::cout << "Snapshot still being written\n";
+    return;
+  }
+
+  // Only the copy into the writer happens on the UI thread
+  m_snapshotStart = std::chrono::steady_clock::now();
+  auto writer = std::make_shared<SnapshotWriter>();
+  m_graph->writeSnapshot(*writer);
+  m_visualizer->writeSnapshot(*writer);
+  m_snapshotBytes = writer->getByteSize();
+  std::cout << "Snapshot captured in "
+            << std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - m_snapshotStart)
+                   .count()
+            << " ms\n";
+
+  m_pendingSnapshot =
+      std::async(std::launch::async, [writer, path = m_snapshotPath]() {
+        return writer->writeFile(path);
+      });
+}
+
+void Application::pollSnapshotWrite() {
+  if (!m_pendingSnapshot.valid() ||
+      m_pendingSnapshot.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+    return;
+  }
+
+  if (m_pendingSnapshot.get()) {
+    std::cout << "Snapshot written to " << m_snapshotPath << " ("
+              << m_snapshotBytes / 1024 << " KiB) in "
+              << std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - m_snapshotStart)
+                     .count()
+              << " ms\n";
+  }
+}
+
+bool Application::restoreSnapshot() {
+  const auto start = std::chrono::steady_clock::now();
+  SnapshotReader reader;
+  if (!reader.open(m_snapshotPath))
+    return false;
+
+  // Restore into a scratch graph and check the traversal against it, so a
+  // bad file leaves the whole session intact
+  Graph graph;
+  if (!graph.restoreSnapshot(reader)) {
+    std::cerr << m_snapshotPath << ": inconsistent graph sections\n";
+    return false;
+  }
+  if (!BFSVisualizer::isValidSnapshot(reader, graph)) {
+    std::cerr << m_snapshotPath << ": inconsistent traversal sections\n";
+    return false;
+  }
+
+  cancelGraphGeneration();
+  selectNode(-1);
+  *m_graph = std::move(graph);
+  m_visualizer->restoreSnapshot(reader); // Checked above
+  m_layout->restart();
+  markGraphChanged();
+
+  std::cout << "Restored " << m_graph->getNodes().size() << " nodes from "
+            << m_snapshotPath << " in "
+            << std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+            << " ms\n";
+  return true;
+}
+
+void Application::markGraphChanged() {
+  m_componentsDirty = true;
+  m_spatialDirty = true;
+  m_renderer.invalidate();
+  m_needsRedraw = true;
+}
+
+void Application::startComponents() {
+  m_componentsDirty = false;
+
+  // Only the adjacency copy happens on the UI thread; edits made while the
+  // worker runs mark the components dirty again for the next job
+  auto adjacency = std::make_shared<CompressedAdjacency>(*m_graph);
+  auto present =
+      std::make_shared<std::vector<std::uint8_t>>(adjacency->getVertexCount());
+  for (const auto &[id, node] : m_graph->getNodes()) {
+    (*present)[id] = 1;
+  }
+  m_pendingComponents =
+      std::async(std::launch::async, [adjacency, present]() {
+        auto components = std::make_unique<ConnectedComponents>();
+        components->run(*adjacency, present.get());
+        return components;
+      });
+}
+
+void Application::pollComponents() {
+  if (!m_pendingComponents.valid() ||
+      m_pendingComponents.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+    return;
+  }
+
+  m_components = m_pendingComponents.get();
+  m_needsRedraw = true;
+  if (!m_showComponents)
+    return;
+
+  // Nodes added since the job started get no colour until the next one
+  for (const auto &[id, node] : m_graph->getNodes()) {
+    int component = m_components->getComponent(id);
+    if (component == -1) {
+      node->setComponentColor(std::nullopt);
+    } else {
+      node->setComponentColor(componentColor(component));
     }
   }
+
+  // Largest components first in the console report
+  std::vector<std::size_t> sizes = m_components->getSizes();
+  std::sort(sizes.begin(), sizes.end(), std::greater<>());
+  std::cout << "Components: " << sizes.size() << " in "
+            << m_components->getMicros() / 1000.0 << " ms; largest:";
+  for (std::size_t i = 0; i < sizes.size() && i < 5; ++i) {
+    std::cout << " " << sizes[i];
+  }
+  std::cout << "\n";
+}
+
+void Application::clearComponentColors() {
+  for (const auto &[id, node] : m_graph->getNodes()) {
+    node->setComponentColor(std::nullopt);
+  }
 }
 
-void Application::update(float deltaTime) { m_visualizer->update(deltaTime); }
+void Application::update(float deltaTime) {
+  pollGraphGeneration();
+  pollSnapshotWrite();
+  pollComponents();
+  if (m_showComponents && m_componentsDirty && !m_pendingComponents.valid()) {
+    startComponents();
+  }
+
+  // A running layout moves nodes every frame. The culling grid is not
+  // rebuilt each time; queries widen by the drift until it grows stale.
+  if (float moved = m_layout->step(); moved > 0.0f) {
+    m_spatialIndex.addDrift(moved);
+    m_renderer.invalidate();
+    m_needsRedraw = true;
+  }
+  m_visualizer->update(deltaTime);
+
+  // Node states may have changed, so the heatmap is out of date too
+  if (m_visualizer->consumeChanges()) {
+    m_renderer.invalidate();
+    m_needsRedraw = true;
+  }
+
+  // Progress bars move while generating. A pending heatmap raster only
+  // causes a redraw once it has landed in the texture.
+  if (isGenerating() || m_renderer.pollRaster()) {
+    m_needsRedraw = true;
+  }
+}
 
 void Application::render() {
   m_window.clear(sf::Color::White);
 
-  // Draw graph
-  m_graph->draw(m_window, m_font);
+  // Draw the graph through the camera, submitting only what is in view
+  if (m_spatialDirty || m_spatialIndex.isStale()) {
+    m_spatialIndex.build(*m_graph);
+    m_spatialDirty = false;
+  }
+  m_window.setView(m_camera);
+  m_renderer.draw(m_window, m_font, *m_graph, m_spatialIndex, m_camera);
+
+  // Overlays are drawn in window coordinates
+  m_window.setView(m_window.getDefaultView());
+  drawCameraInfo();
 
   // Draw BFS visualization elements
   m_visualizer->drawQueue(m_window, m_font);
   m_visualizer->drawInfo(m_window, m_font);
 
+  if (isGenerating()) {
+    drawGenerationProgress();
+  }
+  if (m_editMode) {
+    drawEditHint();
+  }
+  if (m_showComponents && m_components) {
+    drawComponentSummary();
+  }
+
   m_window.display();
 }
+
+void Application::drawEditHint() {
+  sf::Text text(m_font);
+  text.setString("EDIT: click two nodes to toggle an edge, empty space to "
+                 "add a node, Delete removes the selected node");
+  text.setCharacterSize(UI_CONFIG::PROGRESS_FONT_SIZE);
+  text.setPosition({UI_CONFIG::UI_MARGIN,
+                    WINDOW_CONFIG::HEIGHT - UI_CONFIG::UI_MARGIN -
+                        UI_CONFIG::PROGRESS_FONT_SIZE * 1.5f});
+  text.setFillColor(COLOR_CONFIG::SELECTED);
+  m_window.draw(text);
+}
+
+void Application::drawCameraInfo() {
+  std::ostringstream oss;
+  oss.precision(3);
+  oss << "Zoom " << WINDOW_CONFIG::WIDTH / m_camera.getSize().x << "x, "
+      << LodRenderer::getName(m_renderer.getTier()) << " detail";
+  if (m_renderer.getTier() != LodTier::HEATMAP) {
+    oss << ", drawing " << m_renderer.getDrawnNodes() << "/"
+        << m_spatialIndex.getNodeCount() << " nodes, "
+        << m_renderer.getDrawnEdges() << "/" << m_spatialIndex.getEdgeCount()
+        << " edges";
+  }
+
+  // Bottom line, below the component summary and edit hint
+  sf::Text text(m_font);
+  text.setString(oss.str());
+  text.setCharacterSize(UI_CONFIG::PROGRESS_FONT_SIZE);
+  text.setPosition({UI_CONFIG::UI_MARGIN,
+                    WINDOW_CONFIG::HEIGHT - UI_CONFIG::UI_MARGIN -
+                        UI_CONFIG::PROGRESS_FONT_SIZE * 0.5f});
+  text.setFillColor(COLOR_CONFIG::TEXT);
+  m_window.draw(text);
+}
+
+void Application::drawComponentSummary() {
+  std::ostringstream oss;
+  oss.precision(3);
+  oss << "Components: " << m_components->getComponentCount()
+      << " (largest " << m_components->getLargestSize() << " nodes, "
+      << m_components->getMicros() / 1000.0 << " ms)";
+
+  // One line above the edit-mode hint
+  sf::Text text(m_font);
+  text.setString(oss.str());
+  text.setCharacterSize(UI_CONFIG::PROGRESS_FONT_SIZE);
+  text.setPosition({UI_CONFIG::UI_MARGIN,
+                    WINDOW_CONFIG::HEIGHT - UI_CONFIG::UI_MARGIN -
+                        UI_CONFIG::PROGRESS_FONT_SIZE * 3.0f});
+  text.setFillColor(COLOR_CONFIG::TEXT);
+  m_window.draw(text);
+}
+
+void Application::drawGenerationProgress() {
+  const float width = UI_CONFIG::PROGRESS_BAR_WIDTH;
+  const float height = UI_CONFIG::PROGRESS_BAR_HEIGHT;
+  const float x = WINDOW_CONFIG::WIDTH - width - UI_CONFIG::UI_MARGIN;
+  float y = WINDOW_CONFIG::HEIGHT - UI_CONFIG::UI_MARGIN -
+            2.0f * (height + UI_CONFIG::UI_MARGIN);
+
+  const std::pair<const char *, float> phases[] = {
+      {"Placement", m_generationProgress->placement.load()},
+      {"Connectivity", m_generationProgress->connectivity.load()},
+  };
+
+  for (const auto &[label, fraction] : phases) {
+    sf::RectangleShape track(sf::Vector2f(width, height));
+    track.setPosition({x, y});
+    track.setFillColor(COLOR_CONFIG::BACKGROUND);
+    track.setOutlineThickness(2.0f);
+    track.setOutlineColor(COLOR_CONFIG::EDGE);
+    m_window.draw(track);
+
+    sf::RectangleShape bar(
+        sf::Vector2f(width * std::clamp(fraction, 0.0f, 1.0f), height));
+    bar.setPosition({x, y});
+    bar.setFillColor(COLOR_CONFIG::PROGRESS_BAR);
+    m_window.draw(bar);
+
+    sf::Text text(m_font);
+    text.setString(label);
+    text.setCharacterSize(UI_CONFIG::PROGRESS_FONT_SIZE);
+    text.setPosition({x + UI_CONFIG::UI_MARGIN / 2.0f, y});
+    text.setFillColor(COLOR_CONFIG::TEXT);
+    m_window.draw(text);
+
+    y += height + UI_CONFIG::UI_MARGIN;
+  }
+}
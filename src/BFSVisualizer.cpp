@@ -1,11 +1,36 @@
 #include "BFSVisualizer.h"
 #include "Config.h"
+#include "Snapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
 #include <sstream>
 
+namespace {
+// Scalars of the TRAVERSAL section
+struct TraversalRecord {
+  std::uint8_t algorithm;
+  std::uint8_t state;
+  std::uint8_t complete;
+  std::uint8_t autoStep;
+  std::int32_t startNode;
+  std::int32_t currentNode;
+  std::int32_t target;
+  std::uint64_t frontier;
+  std::uint32_t heapLast;
+  float stepDelay;
+};
+} // namespace
+
 BFSVisualizer::BFSVisualizer(Graph &graph)
-    : m_graph(graph), m_state(BFSState::READY), m_currentNode(-1),
-      m_startNode(-1), m_autoStep(false), m_stepDelay(1.0f),
-      m_timeSinceLastStep(0.0f) {}
+    : m_graph(graph), m_state(BFSState::READY),
+      m_algorithm(TraversalAlgorithm::BFS), m_target(-1), m_distances(graph),
+      m_currentNode(-1), m_startNode(-1), m_autoStep(false),
+      m_stepDelay(1.0f), m_timeSinceLastStep(0.0f), m_turbo(false),
+      m_stepsPerSecond(0.0f), m_rateWindowTime(0.0f), m_rateWindowSteps(0),
+      m_queueScroll(0), m_changed(true) {}
 
 void BFSVisualizer::startBFS(int startNodeId) {
   auto startNode = m_graph.getNode(startNodeId);
@@ -13,126 +38,516 @@ void BFSVisualizer::startBFS(int startNodeId) {
     return;
 
   reset();
+  m_target = -1;
+  for (const auto &[id, node] : m_graph.getNodes()) {
+    if (node->isTarget())
+      m_target = id;
+  }
+  freezeHeuristic();
+  rebuildAdjacency();
+  m_distances.setSource(startNodeId);
   m_startNode = startNodeId;
   m_state = BFSState::RUNNING;
 
-  // Initialize BFS
-  m_queue.push(startNodeId);
-  m_visited.insert(startNodeId);
+  // Initialize the traversal; the engine seeds its frontier and reports the
+  // start node as its first DISCOVER event
+  m_context.reset(m_adjacency.getVertexCount());
+  m_pendingStates.assign(m_adjacency.getVertexCount(), NO_PENDING_STATE);
+  m_engine = TraversalEngine::create(m_algorithm, m_adjacency, m_context,
+                                     startNodeId, m_target, &m_heuristic);
+  m_engine.next();
   m_visitOrder.push_back(startNodeId);
 
-  updateNodeStates();
+  markNode(startNodeId, NodeState::IN_QUEUE);
 }
 
 void BFSVisualizer::step() {
+  // A single step is its own timed batch; turbo batches many (see
+  // runTurboSteps)
+  m_batchStart = std::chrono::steady_clock::now();
+  advance();
+  closeBatch();
+}
+
+std::chrono::steady_clock::time_point BFSVisualizer::closeBatch() {
+  const auto now = std::chrono::steady_clock::now();
+  m_stats.addElapsed(
+      std::chrono::duration<double, std::micro>(now - m_batchStart).count());
+  m_batchStart = now;
+  return now;
+}
+
+void BFSVisualizer::advance() {
   if (m_state != BFSState::RUNNING)
     return;
+  m_changed = true;
 
-  if (m_queue.empty()) {
-    m_state = BFSState::FINISHED;
-    m_currentNode = -1;
-    updateNodeStates();
-    return;
+  // The previous current node is fully expanded
+  if (m_currentNode != -1) {
+    markNode(m_currentNode, NodeState::VISITED);
   }
 
-  // Get next node from queue
-  m_currentNode = m_queue.front();
-  m_queue.pop();
-
-  // Visit current node and add unvisited neighbors to queue
-  auto currentNode = m_graph.getNode(m_currentNode);
-  if (currentNode) {
-    for (int neighborId : currentNode->getNeighbors()) {
-      if (m_visited.find(neighborId) == m_visited.end()) {
-        m_visited.insert(neighborId);
-        m_queue.push(neighborId);
-        m_visitOrder.push_back(neighborId);
+  // Pull events until the engine finishes expanding one node
+  size_t discovered = 0;
+  while (m_engine.next()) {
+    const TraversalEvent &event = m_engine.value();
+    switch (event.type) {
+    case TraversalEventType::VISIT:
+      m_currentNode = event.node;
+      markNode(m_currentNode, NodeState::CURRENT);
+      break;
+
+    case TraversalEventType::DISCOVER:
+      m_visitOrder.push_back(event.node);
+      markNode(event.node, NodeState::IN_QUEUE);
+      ++discovered;
+      break;
+
+    case TraversalEventType::RELAX:
+      // Already shown as queued; only its distance and parent changed
+      break;
+
+    case TraversalEventType::EXPANDED:
+      m_stats.recordExpansion(getStatsBucket(event.node), event.value,
+                              discovered);
+      ++m_rateWindowSteps;
+
+      // Check if the traversal is complete
+      if (m_context.complete) {
+        finish();
       }
+      return;
+    }
+  }
+
+  finish();
+}
+
+void BFSVisualizer::finish() {
+  m_state = BFSState::FINISHED;
+  m_changed = true;
+  if (m_currentNode != -1) {
+    markNode(m_currentNode, NodeState::VISITED);
+  }
+  m_currentNode = -1;
+  closeBatch(); // Totals below include the steps that got us here
+
+  // One line per query so algorithms can be compared on the same graph
+  std::cout << TraversalEngine::getName(m_algorithm) << " from "
+            << m_graph.getLabel(m_startNode);
+  if (m_target != -1) {
+    std::cout << " to " << m_graph.getLabel(m_target);
+    if (m_context.settled[m_target]) {
+      std::cout << " (cost " << m_context.distance[m_target] << ")";
+    } else {
+      std::cout << " (unreachable)";
+    }
+  }
+  std::cout << ": settled " << m_stats.getTotalExpanded() << " nodes, "
+            << m_stats.getTotalEdges() << " edges examined, "
+            << m_stats.getTotalMicros() / 1000.0 << " ms\n";
+}
+
+void BFSVisualizer::setAlgorithm(TraversalAlgorithm algorithm) {
+  m_algorithm = algorithm;
+  reset();
+}
+
+void BFSVisualizer::toggleTarget(int nodeId) {
+  bool wasTarget = false;
+  for (const auto &[id, node] : m_graph.getNodes()) {
+    if (id == nodeId)
+      wasTarget = node->isTarget();
+    node->setTarget(false);
+  }
+  if (auto node = m_graph.getNode(nodeId)) {
+    node->setTarget(!wasTarget);
+  }
+  m_changed = true;
+}
+
+void BFSVisualizer::rebuildAdjacency() {
+  m_adjacency = CompressedAdjacency(
+      m_graph, TraversalEngine::getEdgeWeights(m_algorithm));
+  extendHeuristic();
+}
+
+void BFSVisualizer::freezeHeuristic() {
+  // Once per traversal: the layout keeps moving nodes, and estimates
+  // recomputed mid-run would no longer agree with keys already in the heap.
+  // The next rebuildAdjacency() fills the table.
+  m_heuristic.clear();
+  if (auto target = m_graph.getNode(m_target))
+    m_targetPosition = target->getPosition();
+}
+
+void BFSVisualizer::extendHeuristic() {
+  // A* lower bound: floor of the straight-line distance to the target. Edge
+  // weights are ceilings of lengths, so the bound is consistent while nodes
+  // stay where they were when the traversal started.
+  const int first = static_cast<int>(m_heuristic.size());
+  m_heuristic.resize(m_adjacency.getVertexCount(), 0);
+  if (m_algorithm != TraversalAlgorithm::A_STAR || m_target == -1)
+    return;
+  for (int id = first; id < m_adjacency.getVertexCount(); ++id) {
+    if (auto node = m_graph.getNode(id)) {
+      sf::Vector2f delta = m_targetPosition - node->getPosition();
+      m_heuristic[id] = static_cast<std::uint32_t>(
+          std::floor(std::sqrt(delta.x * delta.x + delta.y * delta.y)));
     }
   }
+}
 
-  updateNodeStates();
+int BFSVisualizer::getStatsBucket(int nodeId) const {
+  return static_cast<int>(getStatsBucket(m_algorithm, m_context.level[nodeId],
+                                         m_context.distance[nodeId]));
+}
 
-  // Check if BFS is complete
-  if (m_queue.empty()) {
-    m_state = BFSState::FINISHED;
-    m_currentNode = -1;
-    updateNodeStates();
+std::uint32_t BFSVisualizer::getStatsBucket(TraversalAlgorithm algorithm,
+                                            int level,
+                                            std::uint32_t distance) {
+  switch (algorithm) {
+  case TraversalAlgorithm::BFS:
+    return static_cast<std::uint32_t>(level);
+  case TraversalAlgorithm::ZERO_ONE_BFS:
+    return distance;
+  case TraversalAlgorithm::DIJKSTRA:
+  case TraversalAlgorithm::A_STAR:
+    return distance / ALGO_CONFIG::STATS_DISTANCE_BUCKET;
   }
+  return static_cast<std::uint32_t>(level);
 }
 
 void BFSVisualizer::pause() {
   if (m_state == BFSState::RUNNING) {
     m_state = BFSState::PAUSED;
+    m_changed = true;
   }
 }
 
 void BFSVisualizer::resume() {
   if (m_state == BFSState::PAUSED) {
     m_state = BFSState::RUNNING;
+    m_changed = true;
   }
 }
 
 void BFSVisualizer::reset() {
   m_state = BFSState::READY;
+  m_changed = true;
   m_currentNode = -1;
   m_startNode = -1;
 
   // Clear BFS data structures
-  while (!m_queue.empty())
-    m_queue.pop();
-  m_visited.clear();
+  m_engine = Generator<TraversalEvent>();
+  m_context.reset(0);
+  m_queueScroll = 0;
   m_visitOrder.clear();
+  m_distances.clear();
+  m_stats.clear();
 
+  m_pendingStates.clear();
+  m_pendingIds.clear();
   resetNodeStates();
 }
 
+void BFSVisualizer::scrollQueue(long long delta) {
+  // Clamped against the live queue size again when drawing
+  long long target = static_cast<long long>(m_queueScroll) + delta;
+  const auto size = static_cast<long long>(m_context.queue.size());
+  target = std::max(0LL, std::min(target, size));
+  m_queueScroll = static_cast<size_t>(target);
+  m_changed = true;
+}
+
+void BFSVisualizer::setTurbo(bool enable) {
+  m_turbo = enable;
+  m_changed = true;
+  m_stepsPerSecond = 0.0f;
+  m_rateWindowTime = 0.0f;
+  m_rateWindowSteps = 0;
+}
+
+void BFSVisualizer::onEdgeToggled(int u, int v, bool added) {
+  if (m_state == BFSState::READY)
+    return;
+  m_changed = true;
+
+  // Only the two endpoint lists are re-encoded, so a running traversal
+  // follows the edit in O(degree); the engine is suspended between steps,
+  // so patching underneath it is safe. Once superseded encodings outweigh
+  // the live ones, a full snapshot compacts them away.
+  if (m_adjacency.getDeadBytes() > m_adjacency.getByteSize() / 2) {
+    rebuildAdjacency();
+  } else {
+    m_adjacency.updateVertex(m_graph, u);
+    m_adjacency.updateVertex(m_graph, v);
+    extendHeuristic();
+  }
+  m_context.grow(m_adjacency.getVertexCount());
+
+  const RepairReport &report =
+      added ? m_distances.edgeInserted(u, v) : m_distances.edgeDeleted(u, v);
+  std::cout << "Repaired distances: work " << report.repairWork << " vs "
+            << report.fullWork << " for full BFS ("
+            << report.affectedVertices << " vertices affected)\n";
+}
+
+void BFSVisualizer::writeSnapshot(SnapshotWriter &writer) const {
+  TraversalRecord record{};
+  record.algorithm = static_cast<std::uint8_t>(m_algorithm);
+  record.state = static_cast<std::uint8_t>(m_state);
+  record.complete = m_context.complete;
+  record.autoStep = m_autoStep;
+  record.startNode = m_startNode;
+  record.currentNode = m_currentNode;
+  record.target = m_target;
+  record.frontier = m_context.frontier;
+  record.heapLast = m_context.heap.getLast();
+  record.stepDelay = m_stepDelay;
+  writer.addValue(SnapshotSection::TRAVERSAL, record);
+
+  writer.add(SnapshotSection::LEVELS, m_context.level);
+  writer.add(SnapshotSection::PARENTS, m_context.parent);
+  writer.add(SnapshotSection::DISTANCES, m_context.distance);
+  writer.add(SnapshotSection::SETTLED, m_context.settled);
+  writer.add(SnapshotSection::VISIT_ORDER, m_visitOrder);
+  writer.add(SnapshotSection::LEVEL_STATS, m_stats.getLevels());
+
+  std::vector<int> queue(m_context.queue.size());
+  for (size_t i = 0; i < queue.size(); ++i) {
+    queue[i] = m_context.queue[i];
+  }
+  writer.add(SnapshotSection::QUEUE, std::move(queue));
+
+  std::vector<std::uint32_t> heapKeys;
+  std::vector<int> heapValues;
+  heapKeys.reserve(m_context.heap.size());
+  heapValues.reserve(m_context.heap.size());
+  m_context.heap.forEach([&](const RadixHeap<int>::Entry &entry) {
+    heapKeys.push_back(entry.first);
+    heapValues.push_back(entry.second);
+  });
+  writer.add(SnapshotSection::HEAP_KEYS, std::move(heapKeys));
+  writer.add(SnapshotSection::HEAP_VALUES, std::move(heapValues));
+}
+
+bool BFSVisualizer::isValidSnapshot(const SnapshotReader &reader,
+                                    const Graph &graph) {
+  constexpr auto lastAlgorithm = TraversalAlgorithm::A_STAR;
+  TraversalRecord record{};
+  if (!reader.getValue(SnapshotSection::TRAVERSAL, record) ||
+      record.algorithm > static_cast<std::uint8_t>(lastAlgorithm) ||
+      record.state > static_cast<std::uint8_t>(BFSState::FINISHED)) {
+    return false;
+  }
+  if (static_cast<BFSState>(record.state) == BFSState::READY)
+    return true;
+
+  auto level = reader.get<int>(SnapshotSection::LEVELS);
+  auto parent = reader.get<int>(SnapshotSection::PARENTS);
+  auto distance = reader.get<std::uint32_t>(SnapshotSection::DISTANCES);
+  auto settled = reader.get<std::uint8_t>(SnapshotSection::SETTLED);
+  auto visitOrder = reader.get<int>(SnapshotSection::VISIT_ORDER);
+  auto levels = reader.get<LevelStats>(SnapshotSection::LEVEL_STATS);
+  auto queue = reader.get<int>(SnapshotSection::QUEUE);
+  auto heapKeys = reader.get<std::uint32_t>(SnapshotSection::HEAP_KEYS);
+  auto heapValues = reader.get<int>(SnapshotSection::HEAP_VALUES);
+
+  // TraversalStats indexes its levels by position, and grows them up to
+  // the stats bucket of every node it expands, so the stored rows must sit
+  // at their own index and every reached node's level and bucket must stay
+  // within a node count of the stored rows. Unreached nodes are -1 and
+  // UNREACHED together.
+  for (std::size_t i = 0; i < levels.size(); ++i) {
+    if (levels[i].level != static_cast<int>(i))
+      return false;
+  }
+  const auto algorithm = static_cast<TraversalAlgorithm>(record.algorithm);
+  const std::size_t limit = levels.size() + graph.getNodes().size();
+  for (std::size_t i = 0; i < level.size() && i < distance.size(); ++i) {
+    const bool unreached = level[i] == -1;
+    if (unreached != (distance[i] == TraversalContext::UNREACHED))
+      return false;
+    if (!unreached &&
+        (level[i] < 0 || static_cast<std::size_t>(level[i]) >= limit ||
+         getStatsBucket(algorithm, level[i], distance[i]) >= limit))
+      return false;
+  }
+
+  // Every id the engine will index with must be a node of the graph and
+  // inside both the context arrays and the adjacency, which rebuildAdjacency
+  // sizes to graph.getNextId()
+  const int size = std::min(static_cast<int>(level.size()), graph.getNextId());
+  auto isNode = [size, &graph](int id) {
+    return id >= 0 && id < size && graph.getNode(id) != nullptr;
+  };
+  auto allNodes = [&isNode](std::span<const int> ids) {
+    return std::all_of(ids.begin(), ids.end(), isNode);
+  };
+  // The radix heap only accepts keys at or above its floor
+  auto aboveFloor = [&record](std::uint32_t key) {
+    return key >= record.heapLast;
+  };
+  return parent.size() == level.size() && distance.size() == level.size() &&
+         settled.size() == level.size() &&
+         heapKeys.size() == heapValues.size() && isNode(record.startNode) &&
+         (record.currentNode == -1 || isNode(record.currentNode)) &&
+         (record.target == -1 || isNode(record.target)) && allNodes(queue) &&
+         allNodes(heapValues) && allNodes(visitOrder) &&
+         std::all_of(heapKeys.begin(), heapKeys.end(), aboveFloor);
+}
+
+bool BFSVisualizer::restoreSnapshot(const SnapshotReader &reader) {
+  if (!isValidSnapshot(reader, m_graph))
+    return false;
+
+  reset();
+  TraversalRecord record{};
+  reader.getValue(SnapshotSection::TRAVERSAL, record);
+  m_algorithm = static_cast<TraversalAlgorithm>(record.algorithm);
+  m_autoStep = record.autoStep;
+  m_stepDelay = record.stepDelay;
+  if (static_cast<BFSState>(record.state) == BFSState::READY)
+    return true;
+
+  auto level = reader.get<int>(SnapshotSection::LEVELS);
+  auto parent = reader.get<int>(SnapshotSection::PARENTS);
+  auto distance = reader.get<std::uint32_t>(SnapshotSection::DISTANCES);
+  auto settled = reader.get<std::uint8_t>(SnapshotSection::SETTLED);
+  auto visitOrder = reader.get<int>(SnapshotSection::VISIT_ORDER);
+  auto levels = reader.get<LevelStats>(SnapshotSection::LEVEL_STATS);
+  auto queue = reader.get<int>(SnapshotSection::QUEUE);
+  auto heapKeys = reader.get<std::uint32_t>(SnapshotSection::HEAP_KEYS);
+  auto heapValues = reader.get<int>(SnapshotSection::HEAP_VALUES);
+
+  m_target = record.target;
+  m_startNode = record.startNode;
+  m_currentNode = record.currentNode;
+  freezeHeuristic();
+  rebuildAdjacency();
+  m_distances.setSource(m_startNode);
+
+  m_context.level.assign(level.begin(), level.end());
+  m_context.parent.assign(parent.begin(), parent.end());
+  m_context.distance.assign(distance.begin(), distance.end());
+  m_context.settled.assign(settled.begin(), settled.end());
+  m_context.grow(m_adjacency.getVertexCount());
+  m_pendingStates.assign(m_context.level.size(), NO_PENDING_STATE);
+  m_context.queue.reserve(m_context.level.size());
+  for (int id : queue) {
+    m_context.queue.push_back(id);
+  }
+  m_context.heap.restart(record.heapLast);
+  for (size_t i = 0; i < heapKeys.size(); ++i) {
+    m_context.heap.push(heapKeys[i], heapValues[i]);
+  }
+  m_context.frontier = record.frontier;
+  m_context.complete = record.complete;
+  m_visitOrder.assign(visitOrder.begin(), visitOrder.end());
+  m_stats.restore(std::vector<LevelStats>(levels.begin(), levels.end()));
+
+  // The engine continues from the restored frontier
+  m_state = static_cast<BFSState>(record.state);
+  if (m_state != BFSState::FINISHED) {
+    m_engine = TraversalEngine::create(m_algorithm, m_adjacency, m_context,
+                                       TraversalEngine::RESUME, m_target,
+                                       &m_heuristic);
+  }
+
+  for (int id : m_visitOrder) {
+    markNode(id, m_context.settled[id] ? NodeState::VISITED
+                                       : NodeState::IN_QUEUE);
+  }
+  if (m_currentNode != -1) {
+    markNode(m_currentNode, NodeState::CURRENT);
+  }
+  flushNodeStates();
+  m_changed = true;
+  return true;
+}
+
 void BFSVisualizer::update(float deltaTime) {
   if (m_autoStep && m_state == BFSState::RUNNING) {
-    m_timeSinceLastStep += deltaTime;
-    if (m_timeSinceLastStep >= m_stepDelay) {
-      step();
-      m_timeSinceLastStep = 0.0f;
+    if (m_turbo) {
+      runTurboSteps();
+    } else {
+      m_timeSinceLastStep += deltaTime;
+      if (m_timeSinceLastStep >= m_stepDelay) {
+        step();
+        m_timeSinceLastStep = 0.0f;
+      }
     }
   }
+
+  // Achieved rate over a short sliding window
+  m_rateWindowTime += deltaTime;
+  if (m_rateWindowTime >= ALGO_CONFIG::RATE_WINDOW_SECONDS) {
+    float rate = m_rateWindowSteps / m_rateWindowTime;
+    m_changed = m_changed || (m_turbo && rate != m_stepsPerSecond);
+    m_stepsPerSecond = rate;
+    m_rateWindowTime = 0.0f;
+    m_rateWindowSteps = 0;
+  }
+
+  flushNodeStates();
 }
 
-void BFSVisualizer::updateNodeStates() {
-  // Only update states that have actually changed
-  static std::unordered_set<int> lastVisited;
-  static std::queue<int> lastQueue;
-  static int lastCurrent = -1;
+float BFSVisualizer::getTimeToNextStep() const {
+  if (!m_autoStep || m_state != BFSState::RUNNING)
+    return std::numeric_limits<float>::infinity();
+  if (m_turbo)
+    return 0.0f;
+  return std::max(0.0f, m_stepDelay - m_timeSinceLastStep);
+}
 
-  // Reset all nodes to unvisited
-  for (const auto &[id, node] : m_graph.getNodes()) {
-    node->setState(NodeState::UNVISITED);
-  }
+bool BFSVisualizer::consumeChanges() {
+  bool changed = m_changed;
+  m_changed = false;
+  return changed;
+}
 
-  // Mark visited nodes
-  for (int nodeId : m_visitOrder) {
-    auto node = m_graph.getNode(nodeId);
-    if (node) {
-      node->setState(NodeState::VISITED);
+void BFSVisualizer::runTurboSteps() {
+  using Clock = std::chrono::steady_clock;
+  m_batchStart = Clock::now();
+  const auto deadline =
+      m_batchStart + std::chrono::microseconds(static_cast<long long>(
+                         ALGO_CONFIG::TURBO_FRAME_BUDGET_MS * 1000.0f));
+
+  // Reading the clock costs about as much as a small step, so steps are
+  // untimed and each batch's clock read both checks the budget and is split
+  // across the batch's expansions in the stats
+  while (m_state == BFSState::RUNNING) {
+    for (int i = 0; i < ALGO_CONFIG::TURBO_STEPS_PER_CLOCK_CHECK &&
+                    m_state == BFSState::RUNNING;
+         ++i) {
+      advance();
     }
+    if (closeBatch() >= deadline)
+      break;
   }
+}
 
-  // Mark nodes in queue
-  std::queue<int> tempQueue = m_queue;
-  while (!tempQueue.empty()) {
-    auto node = m_graph.getNode(tempQueue.front());
-    if (node) {
-      node->setState(NodeState::IN_QUEUE);
-    }
-    tempQueue.pop();
+void BFSVisualizer::markNode(int nodeId, NodeState state) {
+  // Sized at start; only ids added by edits mid-traversal grow it
+  if (nodeId >= static_cast<int>(m_pendingStates.size())) {
+    m_pendingStates.resize(nodeId + 1, NO_PENDING_STATE);
+  }
+  if (m_pendingStates[nodeId] == NO_PENDING_STATE) {
+    m_pendingIds.push_back(nodeId);
   }
+  // Last change within a frame wins
+  m_pendingStates[nodeId] = static_cast<std::int8_t>(state);
+}
 
-  // Mark current node
-  if (m_currentNode != -1) {
-    auto node = m_graph.getNode(m_currentNode);
-    if (node) {
-      node->setState(NodeState::CURRENT);
+void BFSVisualizer::flushNodeStates() {
+  for (int nodeId : m_pendingIds) {
+    if (auto node = m_graph.getNode(nodeId)) {
+      node->setState(static_cast<NodeState>(m_pendingStates[nodeId]));
     }
+    m_pendingStates[nodeId] = NO_PENDING_STATE;
   }
+  m_pendingIds.clear();
 }
 
 void BFSVisualizer::resetNodeStates() {
@@ -146,6 +561,7 @@ void BFSVisualizer::drawQueue(sf::RenderWindow &window, sf::Font &font) const {
   const float startY = UI_CONFIG::UI_MARGIN;
   const float boxWidth = UI_CONFIG::QUEUE_BOX_WIDTH;
   const float boxHeight = UI_CONFIG::QUEUE_BOX_HEIGHT;
+  const float boxStride = boxWidth + UI_CONFIG::QUEUE_BOX_SPACING;
 
   // Title
   sf::Text title(font);
@@ -155,32 +571,118 @@ void BFSVisualizer::drawQueue(sf::RenderWindow &window, sf::Font &font) const {
   title.setFillColor(COLOR_CONFIG::TEXT);
   window.draw(title);
 
-  // Queue visualization
-  std::queue<int> tempQueue = m_queue;
-  float x = startX + title.getLocalBounds().size.x + UI_CONFIG::UI_MARGIN;
-  float y = startY + title.getLocalBounds().size.y / 2.0f;
-
-  while (!tempQueue.empty()) {
-    // Draw box
-    sf::RectangleShape box(sf::Vector2f(boxWidth, boxHeight));
-    box.setPosition({x, y});
-    box.setFillColor(COLOR_CONFIG::QUEUE_BOX);
-    box.setOutlineThickness(2.0f);
-    box.setOutlineColor(sf::Color::Black);
-    window.draw(box);
-
-    // Draw number
+  const float x0 =
+      startX + title.getLocalBounds().size.x + UI_CONFIG::UI_MARGIN;
+  const float y = startY + title.getLocalBounds().size.y / 2.0f;
+  const size_t queueSize = m_context.queue.size();
+
+  // Priority-queue engines have no meaningful order to draw
+  if (!TraversalEngine::usesQueue(m_algorithm)) {
+    if (m_state == BFSState::READY)
+      return;
+    sf::Text summary(font);
+    summary.setString(std::to_string(m_context.frontier) + " open, " +
+                      std::to_string(m_context.heap.size()) +
+                      " radix heap entries");
+    summary.setCharacterSize(UI_CONFIG::QUEUE_BOX_FONT_SIZE);
+    summary.setPosition({x0, y});
+    summary.setFillColor(COLOR_CONFIG::TEXT);
+    window.draw(summary);
+    return;
+  }
+
+  if (queueSize == 0)
+    return;
+
+  // Work out which slots are visible. When the queue overflows the row, show
+  // a scrollable head window, one elision slot for the entries between it
+  // and the tail, and the last few entries. Scrolled to the end, the head
+  // window meets the tail and the elision slot is dropped; the entries
+  // scrolled past are counted by the position readout instead.
+  const size_t slots = std::max<size_t>(
+      3, static_cast<size_t>((WINDOW_CONFIG::WIDTH - UI_CONFIG::UI_MARGIN -
+                              x0) /
+                             boxStride));
+  size_t headStart = 0;
+  size_t headCount = queueSize;
+  size_t tailCount = 0;
+  if (queueSize > slots) {
+    tailCount = std::max<size_t>(1, slots / UI_CONFIG::QUEUE_TAIL_DIVISOR);
+    headCount = slots - tailCount - 1;
+    headStart = std::min(m_queueScroll, queueSize - tailCount - headCount);
+  }
+  const size_t elided = queueSize - tailCount - (headStart + headCount);
+
+  // (queue index, or -1 for the elision slot) for each visible slot
+  std::vector<long long> visible;
+  visible.reserve(slots);
+  for (size_t i = 0; i < headCount; ++i) {
+    visible.push_back(static_cast<long long>(headStart + i));
+  }
+  if (tailCount > 0) {
+    if (elided > 0) {
+      visible.push_back(-1);
+    }
+    for (size_t i = queueSize - tailCount; i < queueSize; ++i) {
+      visible.push_back(static_cast<long long>(i));
+    }
+  }
+
+  // All boxes go out in one draw call: an outline quad behind a fill quad
+  sf::VertexArray boxes(sf::PrimitiveType::Triangles);
+  auto appendQuad = [&boxes](sf::Vector2f pos, sf::Vector2f size,
+                             sf::Color color) {
+    sf::Vector2f corners[4] = {pos,
+                               {pos.x + size.x, pos.y},
+                               {pos.x + size.x, pos.y + size.y},
+                               {pos.x, pos.y + size.y}};
+    for (int index : {0, 1, 2, 0, 2, 3}) {
+      boxes.append(sf::Vertex{corners[index], color, {}});
+    }
+  };
+
+  const float outline = 2.0f;
+  float x = x0;
+  for (long long index : visible) {
+    appendQuad({x - outline, y - outline},
+               {boxWidth + 2 * outline, boxHeight + 2 * outline},
+               sf::Color::Black);
+    appendQuad({x, y}, {boxWidth, boxHeight},
+               index < 0 ? COLOR_CONFIG::BACKGROUND : COLOR_CONFIG::QUEUE_BOX);
+    x += boxStride;
+  }
+  window.draw(boxes);
+
+  // Labels: bounded by the number of visible slots, not the queue length
+  x = x0;
+  for (long long index : visible) {
     sf::Text number(font);
-    number.setString(std::to_string(tempQueue.front()));
-    number.setCharacterSize(UI_CONFIG::QUEUE_BOX_FONT_SIZE);
+    if (index < 0) {
+      number.setString("+" + std::to_string(elided));
+      number.setCharacterSize(UI_CONFIG::QUEUE_ELIDED_FONT_SIZE);
+    } else {
+      number.setString(
+          std::to_string(m_graph.getLabel(m_context.queue[index])));
+      number.setCharacterSize(UI_CONFIG::QUEUE_BOX_FONT_SIZE);
+    }
     sf::FloatRect bounds = number.getLocalBounds();
     number.setPosition({x + boxWidth / 2.0f - bounds.size.x / 2.0f,
                         y + boxHeight / 2.0f - bounds.size.y / 2.0f - 10.0f});
     number.setFillColor(sf::Color::Black);
     window.draw(number);
+    x += boxStride;
+  }
 
-    tempQueue.pop();
-    x += boxWidth + 5.0f;
+  // Position readout once the queue no longer fits
+  if (tailCount > 0) {
+    sf::Text position(font);
+    position.setString("[" + std::to_string(headStart) + "-" +
+                       std::to_string(headStart + headCount - 1) + " of " +
+                       std::to_string(queueSize) + "]  Left/Right scroll");
+    position.setCharacterSize(UI_CONFIG::QUEUE_ELIDED_FONT_SIZE);
+    position.setPosition({x0, y + boxHeight + UI_CONFIG::QUEUE_BOX_SPACING});
+    position.setFillColor(COLOR_CONFIG::TEXT);
+    window.draw(position);
   }
 }
 
@@ -208,33 +710,87 @@ void BFSVisualizer::drawInfo(sf::RenderWindow &window, sf::Font &font) const {
     break;
   }
   info.push_back(stateStr);
+  info.push_back(std::string("Algorithm: ") +
+                 TraversalEngine::getName(m_algorithm));
+
+  // Path cost once the target has been settled
+  if (m_target != -1 && m_state != BFSState::READY &&
+      m_target < static_cast<int>(m_context.settled.size()) &&
+      m_context.settled[m_target]) {
+    info.push_back("Target " + std::to_string(m_graph.getLabel(m_target)) +
+                   ": cost " + std::to_string(m_context.distance[m_target]));
+  }
+
+  // Turbo throughput
+  if (m_turbo) {
+    std::ostringstream oss;
+    oss << "Turbo: " << static_cast<long long>(m_stepsPerSecond)
+        << " steps/s";
+    info.push_back(oss.str());
+  }
 
   // Current node
   if (m_currentNode != -1) {
-    info.push_back("Current Node: " + std::to_string(m_currentNode));
+    info.push_back("Current Node: " +
+                   std::to_string(m_graph.getLabel(m_currentNode)));
   }
 
-  // Visit order
-  if (!m_visitOrder.empty()) {
+  // Incrementally maintained distance levels and the cost of the last edit
+  if (m_distances.hasSource()) {
+    info.push_back("Levels: " + std::to_string(m_distances.getMaxDistance()) +
+                   ", reachable: " +
+                   std::to_string(m_distances.getReachableCount()));
+
+    const RepairReport &report = m_distances.getLastReport();
     std::ostringstream oss;
-    oss << "Visit Order: \n";
-    for (size_t i = 0; i < m_visitOrder.size(); ++i) {
-      if (i > 0)
-        oss << " -> ";
-      oss << m_visitOrder[i];
-    }
+    oss.precision(3);
+    oss << "Last update: " << report.repairWork << " / " << report.fullWork
+        << " work (" << report.repairMicros << " / ~" << report.fullMicros
+        << " us)";
+    info.push_back(oss.str());
+  }
+
+  // Adjacency footprint of the running traversal
+  if (m_state != BFSState::READY && m_adjacency.getEdgeCount() > 0) {
+    std::ostringstream oss;
+    oss.precision(3);
+    oss << "Adjacency: " << m_adjacency.getBitsPerEdge() << " bits/edge";
     info.push_back(oss.str());
   }
 
+  // Traversal totals plus a frontier-size histogram (one bar per level, or
+  // per distance bucket for weighted engines)
+  // reserving a few blank lines of panel space below this entry
+  size_t histogramLine = 0;
+  if (m_stats.getTotalExpanded() > 0) {
+    std::ostringstream oss;
+    oss.precision(3);
+    oss << "Visited: " << m_visitOrder.size()
+        << ", edges: " << m_stats.getTotalEdges() << ", "
+        << m_stats.getTotalMicros() / 1000.0 << " ms";
+    info.push_back(oss.str());
+    const bool byLevel = m_algorithm == TraversalAlgorithm::BFS;
+    info.push_back(std::string(byLevel ? "Frontier per level"
+                                       : "Settled per distance") +
+                   " (max " + std::to_string(m_stats.getLargestFrontier()) +
+                   "):");
+    histogramLine = info.size();
+    for (int i = 0; i < UI_CONFIG::HISTOGRAM_LINES; ++i) {
+      info.push_back("");
+    }
+  }
+
   // Controls
   info.push_back("");
-  info.push_back("");
   info.push_back("Controls:");
-  info.push_back("Space: Step / Start");
-  info.push_back("R: Reset");
-  info.push_back("A: Auto-step toggle");
-  info.push_back("G: Generate new graph");
-  info.push_back("Click node to start BFS");
+  info.push_back("Space: Step   R: Reset");
+  info.push_back("A: Auto-step   T: Turbo");
+  info.push_back("G: New graph (again: cancel)");
+  info.push_back("O: Reorder   L: Layout");
+  info.push_back("E: Edit   X: Export stats");
+  info.push_back("M: Algorithm");
+  info.push_back("Click node to start");
+  info.push_back("Shift+click: set target");
 
   // Draw info
   for (size_t i = 0; i < info.size(); ++i) {
@@ -245,4 +801,46 @@ void BFSVisualizer::drawInfo(sf::RenderWindow &window, sf::Font &font) const {
     text.setFillColor(COLOR_CONFIG::TEXT);
     window.draw(text);
   }
+
+  if (histogramLine > 0) {
+    drawHistogram(window, {startX, startY + histogramLine * lineHeight},
+                  {UI_CONFIG::HISTOGRAM_WIDTH,
+                   UI_CONFIG::HISTOGRAM_LINES * lineHeight});
+  }
+}
+
+void BFSVisualizer::drawHistogram(sf::RenderWindow &window,
+                                  sf::Vector2f position,
+                                  sf::Vector2f size) const {
+  const auto &levels = m_stats.getLevels();
+  if (levels.empty())
+    return;
+
+  // Merge adjacent levels into one bar once there are more levels than bars
+  const size_t maxBars = UI_CONFIG::HISTOGRAM_MAX_BARS;
+  const size_t levelsPerBar = (levels.size() + maxBars - 1) / maxBars;
+  std::vector<size_t> barTotals((levels.size() + levelsPerBar - 1) /
+                                levelsPerBar);
+  for (const auto &stats : levels) {
+    barTotals[stats.level / levelsPerBar] += stats.frontierSize;
+  }
+
+  const float barWidth = size.x / barTotals.size();
+  const float peak = static_cast<float>(
+      *std::max_element(barTotals.begin(), barTotals.end()));
+
+  sf::VertexArray bars(sf::PrimitiveType::Triangles);
+  for (size_t bar = 0; bar < barTotals.size(); ++bar) {
+    float height = peak > 0.0f ? size.y * barTotals[bar] / peak : 0.0f;
+    float left = position.x + bar * barWidth;
+    float right = left + std::max(1.0f, barWidth - 1.0f);
+    float bottom = position.y + size.y;
+    float top = bottom - height;
+    sf::Vector2f corners[4] = {
+        {left, top}, {right, top}, {right, bottom}, {left, bottom}};
+    for (int index : {0, 1, 2, 0, 2, 3}) {
+      bars.append(sf::Vertex{corners[index], COLOR_CONFIG::HISTOGRAM, {}});
+    }
+  }
+  window.draw(bars);
 }
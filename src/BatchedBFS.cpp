@@ -0,0 +1,181 @@
+#include "BatchedBFS.h"
+#include "Config.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+
+BatchedBFS::BatchedBFS(const CompressedAdjacency &adjacency)
+    : m_adjacency(adjacency), m_seen(adjacency.getVertexCount(), 0),
+      m_frontier(adjacency.getVertexCount(), 0),
+      m_next(adjacency.getVertexCount(), 0) {}
+
+std::size_t BatchedBFS::run(std::span<BfsQuery> queries) {
+  // Lane assignment: one lane per distinct source, in arrival order
+  std::vector<int> sources;
+  std::vector<int> queryLane;
+  std::array<int, LANES> pathSlot;
+  pathSlot.fill(-1);
+  int pathLanes = 0;
+
+  std::size_t taken = 0;
+  for (; taken < queries.size(); ++taken) {
+    BfsQuery &query = queries[taken];
+    auto found = std::find(sources.begin(), sources.end(), query.source);
+    int lane = static_cast<int>(found - sources.begin());
+    bool newLane = found == sources.end();
+    bool newPath =
+        query.kind == QueryKind::PATH && (newLane || pathSlot[lane] < 0);
+    if ((newLane && lane == LANES) ||
+        (newPath && pathLanes == SERVER_CONFIG::MAX_PATH_LANES)) {
+      break;
+    }
+
+    if (newLane)
+      sources.push_back(query.source);
+    if (newPath)
+      pathSlot[lane] = pathLanes++;
+    queryLane.push_back(lane);
+    query.distance = -1;
+    query.levels.clear();
+    query.path.clear();
+  }
+
+  m_laneCount = static_cast<int>(sources.size());
+  if (m_parents.size() < static_cast<std::size_t>(pathLanes)) {
+    m_parents.resize(pathLanes,
+                     std::vector<int>(m_adjacency.getVertexCount()));
+  }
+
+  // Seed level 0
+  std::uint64_t pathMask = 0;
+  std::uint64_t levelsMask = 0;
+  for (std::size_t i = 0; i < taken; ++i) {
+    std::uint64_t bit = std::uint64_t{1} << queryLane[i];
+    if (queries[i].kind == QueryKind::PATH)
+      pathMask |= bit;
+    if (queries[i].kind == QueryKind::LEVELS)
+      levelsMask |= bit;
+  }
+
+  std::vector<std::vector<std::uint32_t>> laneLevels(m_laneCount);
+  for (int lane = 0; lane < m_laneCount; ++lane) {
+    int source = sources[lane];
+    if (m_seen[source] == 0) {
+      m_visited.push_back(source);
+      m_frontierList.push_back(source);
+    }
+    m_seen[source] |= std::uint64_t{1} << lane;
+    m_frontier[source] |= std::uint64_t{1} << lane;
+    if (pathSlot[lane] >= 0)
+      m_parents[pathSlot[lane]][source] = source;
+    laneLevels[lane].push_back(1);
+  }
+
+  // Target queries still waiting for their target's bit
+  std::vector<std::size_t> pending;
+  for (std::size_t i = 0; i < taken; ++i) {
+    if (queries[i].kind != QueryKind::LEVELS)
+      pending.push_back(i);
+  }
+
+  int level = 0;
+  std::uint64_t alive = m_laneCount == LANES
+                            ? ~std::uint64_t{0}
+                            : (std::uint64_t{1} << m_laneCount) - 1;
+  while (true) {
+    // Answer every target reached at this level
+    std::uint64_t pendingLanes = 0;
+    for (std::size_t k = 0; k < pending.size();) {
+      BfsQuery &query = queries[pending[k]];
+      std::uint64_t bit = std::uint64_t{1} << queryLane[pending[k]];
+      if (m_seen[query.target] & bit) {
+        query.distance = level;
+        pending[k] = pending.back();
+        pending.pop_back();
+      } else {
+        pendingLanes |= bit;
+        ++k;
+      }
+    }
+
+    std::uint64_t active = (pendingLanes | levelsMask) & alive;
+    if (active == 0)
+      break;
+
+    // Push every active lane of the frontier to its neighbours. The first
+    // vertex to reach v on a PATH lane becomes v's parent on that lane.
+    for (int vertex : m_frontierList) {
+      std::uint64_t bits = m_frontier[vertex] & active;
+      m_frontier[vertex] = 0;
+      if (bits == 0)
+        continue;
+      for (int neighborId : m_adjacency.neighbors(vertex)) {
+        std::uint64_t fresh = bits & ~m_seen[neighborId];
+        if (fresh == 0)
+          continue;
+        for (std::uint64_t parented = fresh & pathMask & ~m_next[neighborId];
+             parented != 0; parented &= parented - 1) {
+          int lane = std::countr_zero(parented);
+          m_parents[pathSlot[lane]][neighborId] = vertex;
+        }
+        if (m_next[neighborId] == 0)
+          m_nextList.push_back(neighborId);
+        m_next[neighborId] |= fresh;
+      }
+    }
+    m_frontierList.clear();
+    ++level;
+
+    // Commit the next level
+    std::array<std::uint32_t, LANES> counts{};
+    alive = 0;
+    for (int vertex : m_nextList) {
+      std::uint64_t bits = m_next[vertex];
+      m_next[vertex] = 0;
+      if (m_seen[vertex] == 0)
+        m_visited.push_back(vertex);
+      m_seen[vertex] |= bits;
+      m_frontier[vertex] = bits;
+      m_frontierList.push_back(vertex);
+      alive |= bits;
+      for (std::uint64_t counted = bits & levelsMask; counted != 0;
+           counted &= counted - 1) {
+        ++counts[std::countr_zero(counted)];
+      }
+    }
+    m_nextList.clear();
+    for (std::uint64_t grown = alive & levelsMask; grown != 0;
+         grown &= grown - 1) {
+      int lane = std::countr_zero(grown);
+      laneLevels[lane].push_back(counts[lane]);
+    }
+  }
+  m_levelCount = level + 1;
+
+  // Results; pending queries keep distance -1 (unreachable)
+  for (std::size_t i = 0; i < taken; ++i) {
+    BfsQuery &query = queries[i];
+    int lane = queryLane[i];
+    if (query.kind == QueryKind::LEVELS) {
+      query.levels = laneLevels[lane];
+      query.distance = static_cast<int>(query.levels.size()) - 1;
+    } else if (query.kind == QueryKind::PATH && query.distance >= 0) {
+      const std::vector<int> &parent = m_parents[pathSlot[lane]];
+      for (int vertex = query.target; vertex != query.source;
+           vertex = parent[vertex]) {
+        query.path.push_back(vertex);
+      }
+      query.path.push_back(query.source);
+      std::reverse(query.path.begin(), query.path.end());
+    }
+  }
+
+  // Leave every mask zero for the next batch
+  for (int vertex : m_visited) {
+    m_seen[vertex] = 0;
+    m_frontier[vertex] = 0;
+  }
+  m_visited.clear();
+  m_frontierList.clear();
+  return taken;
+}
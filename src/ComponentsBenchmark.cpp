@@ -0,0 +1,100 @@
+#include "ComponentsBenchmark.h"
+#include "CompressedAdjacency.h"
+#include "ConnectedComponents.h"
+#include "Philox.h"
+#include "RingBuffer.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace {
+// Grid whose right and down edges each survive with probability 1/2
+CompressedAdjacency buildPercolatedGrid(int side, std::uint64_t seed) {
+  Philox4x32 rng(seed);
+  std::vector<std::vector<int>> neighborLists(side * side);
+  for (int row = 0; row < side; ++row) {
+    for (int col = 0; col < side; ++col) {
+      int vertex = row * side + col;
+      std::uint32_t bits = rng();
+      if (col + 1 < side && (bits & 1)) {
+        neighborLists[vertex].push_back(vertex + 1);
+        neighborLists[vertex + 1].push_back(vertex);
+      }
+      if (row + 1 < side && (bits & 2)) {
+        neighborLists[vertex].push_back(vertex + side);
+        neighborLists[vertex + side].push_back(vertex);
+      }
+    }
+  }
+  return CompressedAdjacency(std::move(neighborLists));
+}
+
+// Reference labelling: components numbered by smallest vertex, like
+// ConnectedComponents
+std::vector<int> sequentialComponents(const CompressedAdjacency &adjacency) {
+  std::vector<int> labels(adjacency.getVertexCount(), -1);
+  RingBuffer<int> queue;
+  int next = 0;
+  for (int root = 0; root < adjacency.getVertexCount(); ++root) {
+    if (labels[root] != -1)
+      continue;
+    labels[root] = next;
+    queue.push_back(root);
+    while (!queue.empty()) {
+      int current = queue.front();
+      queue.pop_front();
+      for (int neighborId : adjacency.neighbors(current)) {
+        if (labels[neighborId] == -1) {
+          labels[neighborId] = next;
+          queue.push_back(neighborId);
+        }
+      }
+    }
+    ++next;
+  }
+  return labels;
+}
+} // namespace
+
+ComponentsBenchmark::ComponentsBenchmark(ComponentsBenchmarkOptions options)
+    : m_options(options) {}
+
+bool ComponentsBenchmark::run() {
+  const int side = m_options.gridSide;
+  std::cout << "Building " << side << "x" << side << " percolated grid..."
+            << std::endl;
+  CompressedAdjacency adjacency = buildPercolatedGrid(side, 1);
+
+  ConnectedComponents components(m_options.threads);
+  double best = 0.0;
+  for (int repeat = 0; repeat < m_options.repeats; ++repeat) {
+    components.run(adjacency);
+    if (repeat == 0 || components.getMicros() < best)
+      best = components.getMicros();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<int> expected = sequentialComponents(adjacency);
+  double sequentialMicros = std::chrono::duration<double, std::micro>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+  for (int v = 0; v < adjacency.getVertexCount(); ++v) {
+    if (components.getComponent(v) != expected[v]) {
+      std::cerr << "Component mismatch at vertex " << v << std::endl;
+      return false;
+    }
+  }
+
+  std::cout << adjacency.getVertexCount() << " vertices, "
+            << adjacency.getEdgeCount() / 2 << " edges, "
+            << components.getComponentCount() << " components (largest "
+            << components.getLargestSize() << "), best of "
+            << m_options.repeats << ":" << std::endl;
+  std::cout << "  union-find: " << best / 1000.0 << " ms, "
+            << static_cast<double>(adjacency.getEdgeCount()) / best
+            << " M adjacency entries/s" << std::endl;
+  std::cout << "  sequential BFS: " << sequentialMicros / 1000.0 << " ms"
+            << std::endl;
+  return true;
+}
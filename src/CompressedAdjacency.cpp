@@ -0,0 +1,231 @@
+#include "CompressedAdjacency.h"
+#include "Config.h"
+#include "Graph.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr std::size_t TAIL_PADDING = 8;
+
+std::uint64_t zigzagEncode(std::int64_t v) {
+  return (static_cast<std::uint64_t>(v) << 1) ^
+         static_cast<std::uint64_t>(v >> 63);
+}
+
+std::int64_t zigzagDecode(std::uint64_t v) {
+  return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+std::uint32_t bitWidth(std::uint64_t v) {
+  std::uint32_t width = 0;
+  while (v >> width)
+    ++width;
+  return width;
+}
+} // namespace
+
+CompressedAdjacency::CompressedAdjacency(const Graph &graph,
+                                         EdgeWeights weights)
+    : m_weightKind(weights) {
+  int maxId = -1;
+  for (const auto &[id, node] : graph.getNodes()) {
+    maxId = std::max(maxId, id);
+  }
+
+  std::vector<std::vector<int>> neighborLists(maxId + 1);
+  for (const auto &[id, node] : graph.getNodes()) {
+    neighborLists[id] = node->getNeighbors();
+  }
+  encode(neighborLists);
+
+  if (m_weightKind == EdgeWeights::NONE)
+    return;
+
+  // Weights follow the encoded (sorted) neighbor order
+  m_weightOffsets.clear();
+  m_weightOffsets.reserve(getVertexCount());
+  m_weights.reserve(m_edgeCount);
+  for (int vertex = 0; vertex < getVertexCount(); ++vertex) {
+    m_weightOffsets.push_back(m_weights.size());
+    appendWeights(graph, vertex);
+  }
+}
+
+void CompressedAdjacency::updateVertex(const Graph &graph, int vertex) {
+  // Appending goes in front of the tail padding (absent if never encoded)
+  m_data.resize(m_data.size() >= TAIL_PADDING ? m_data.size() - TAIL_PADDING
+                                              : 0);
+
+  // Ids past the end (nodes added since the snapshot) get empty lists
+  while (vertex >= getVertexCount()) {
+    m_offsets.push_back(m_data.size());
+    appendVarint(m_data, 0);
+    if (m_weightKind != EdgeWeights::NONE) {
+      m_weightOffsets.push_back(m_weights.size());
+    }
+  }
+
+  // Re-encode at the end and repoint the vertex there; the old encoding
+  // stays behind as dead bytes until the next full snapshot
+  m_deadBytes += getEncodedSize(vertex);
+  m_edgeCount -= getDegree(vertex);
+  std::vector<int> list;
+  if (auto node = graph.getNode(vertex)) {
+    list = node->getNeighbors();
+  }
+  m_offsets[vertex] = m_data.size();
+  encodeList(vertex, list);
+
+  m_data.resize(m_data.size() + TAIL_PADDING, 0);
+
+  if (m_weightKind != EdgeWeights::NONE) {
+    m_weightOffsets[vertex] = m_weights.size();
+    appendWeights(graph, vertex);
+  }
+}
+
+void CompressedAdjacency::appendWeights(const Graph &graph, int vertex) {
+  for (int neighborId : neighbors(vertex)) {
+    sf::Vector2f delta = graph.getNode(neighborId)->getPosition() -
+                         graph.getNode(vertex)->getPosition();
+    float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    if (m_weightKind == EdgeWeights::LENGTH) {
+      m_weights.push_back(static_cast<std::uint32_t>(std::ceil(length)));
+    } else {
+      m_weights.push_back(length <= ALGO_CONFIG::FREE_EDGE_MAX_LENGTH ? 0
+                                                                      : 1);
+    }
+  }
+}
+
+CompressedAdjacency::CompressedAdjacency(
+    std::vector<std::vector<int>> neighborLists) {
+  encode(neighborLists);
+}
+
+void CompressedAdjacency::encode(std::vector<std::vector<int>> &neighborLists) {
+  m_offsets.clear();
+  m_offsets.reserve(neighborLists.size());
+  m_data.clear();
+  m_deadBytes = 0;
+  m_edgeCount = 0;
+
+  for (size_t vertex = 0; vertex < neighborLists.size(); ++vertex) {
+    m_offsets.push_back(m_data.size());
+    encodeList(static_cast<int>(vertex), neighborLists[vertex]);
+  }
+
+  m_data.resize(m_data.size() + TAIL_PADDING, 0);
+  m_data.shrink_to_fit();
+}
+
+void CompressedAdjacency::encodeList(int vertex, std::vector<int> &list) {
+  std::sort(list.begin(), list.end());
+  list.erase(std::unique(list.begin(), list.end()), list.end());
+
+  appendVarint(m_data, list.size());
+  if (list.empty())
+    return;
+
+  m_gaps.clear();
+  std::uint64_t maxGap = 0;
+  for (size_t i = 1; i < list.size(); ++i) {
+    m_gaps.push_back(static_cast<std::uint64_t>(list[i] - list[i - 1] - 1));
+    maxGap = std::max(maxGap, m_gaps.back());
+  }
+  std::uint32_t width = bitWidth(maxGap);
+
+  m_data.push_back(static_cast<std::uint8_t>(width));
+  appendVarint(m_data, zigzagEncode(static_cast<std::int64_t>(list[0]) -
+                                    static_cast<std::int64_t>(vertex)));
+
+  // Pack gaps LSB-first starting on a fresh byte
+  std::size_t base = m_data.size();
+  m_data.resize(base + (m_gaps.size() * width + 7) / 8, 0);
+  std::uint64_t bit = 0;
+  for (std::uint64_t gap : m_gaps) {
+    for (std::uint32_t b = 0; b < width; ++b, ++bit) {
+      if ((gap >> b) & 1) {
+        m_data[base + (bit >> 3)] |= static_cast<std::uint8_t>(1u << (bit & 7));
+      }
+    }
+  }
+  m_edgeCount += list.size();
+}
+
+CompressedAdjacency::NeighborRange
+CompressedAdjacency::neighbors(int vertex) const {
+  if (vertex < 0 || vertex >= getVertexCount()) {
+    return NeighborRange(NeighborIterator(), 0);
+  }
+
+  const std::uint8_t *in = m_data.data() + m_offsets[vertex];
+  auto degree = static_cast<std::uint32_t>(readVarint(in));
+  if (degree == 0) {
+    return NeighborRange(NeighborIterator(), 0);
+  }
+
+  std::uint32_t width = *in++;
+  int first = vertex + static_cast<int>(zigzagDecode(readVarint(in)));
+  return NeighborRange(NeighborIterator(in, 0, width, degree, first), degree);
+}
+
+std::uint32_t CompressedAdjacency::getDegree(int vertex) const {
+  if (vertex < 0 || vertex >= getVertexCount())
+    return 0;
+  const std::uint8_t *in = m_data.data() + m_offsets[vertex];
+  return static_cast<std::uint32_t>(readVarint(in));
+}
+
+const std::uint32_t *CompressedAdjacency::weights(int vertex) const {
+  if (m_weightKind == EdgeWeights::NONE || vertex < 0 ||
+      vertex >= getVertexCount())
+    return nullptr;
+  return m_weights.data() + m_weightOffsets[vertex];
+}
+
+std::size_t CompressedAdjacency::getEncodedSize(int vertex) const {
+  const std::uint8_t *start = m_data.data() + m_offsets[vertex];
+  const std::uint8_t *in = start;
+  auto degree = readVarint(in);
+  if (degree == 0)
+    return in - start;
+  std::uint32_t width = *in++;
+  readVarint(in);
+  return (in - start) + ((degree - 1) * width + 7) / 8;
+}
+
+std::size_t CompressedAdjacency::getByteSize() const {
+  // Neighbor encoding only; edge weights are not counted
+  return m_data.size() + m_offsets.size() * sizeof(std::uint64_t);
+}
+
+double CompressedAdjacency::getBitsPerEdge() const {
+  if (m_edgeCount == 0)
+    return 0.0;
+  return 8.0 * static_cast<double>(getByteSize()) / m_edgeCount;
+}
+
+void CompressedAdjacency::appendVarint(std::vector<std::uint8_t> &out,
+                                       std::uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(v));
+}
+
+std::uint64_t CompressedAdjacency::readVarint(const std::uint8_t *&in) {
+  // Single-byte fast path covers almost every degree and first-gap value
+  if (*in < 0x80) {
+    return *in++;
+  }
+  std::uint64_t value = 0;
+  int shift = 0;
+  while (*in & 0x80) {
+    value |= static_cast<std::uint64_t>(*in++ & 0x7F) << shift;
+    shift += 7;
+  }
+  value |= static_cast<std::uint64_t>(*in++) << shift;
+  return value;
+}
@@ -0,0 +1,141 @@
+#include "ConnectedComponents.h"
+#include "Config.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+ConnectedComponents::ConnectedComponents(unsigned int threads)
+    : m_threads(threads) {
+  if (m_threads == 0) {
+    m_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+// Relaxed ordering is enough throughout: only the final forest matters and
+// it is read after every worker has been joined
+std::uint32_t ConnectedComponents::find(Parent *parent, std::uint32_t vertex) {
+  while (true) {
+    std::uint32_t up = parent[vertex].load(std::memory_order_relaxed);
+    if (up == vertex)
+      return vertex;
+    std::uint32_t grand = parent[up].load(std::memory_order_relaxed);
+    if (grand != up) {
+      // Path halving; losing the race just leaves a longer path
+      parent[vertex].compare_exchange_weak(up, grand,
+                                           std::memory_order_relaxed);
+    }
+    vertex = grand;
+  }
+}
+
+void ConnectedComponents::unite(Parent *parent, std::uint32_t a,
+                                std::uint32_t b) {
+  while (true) {
+    a = find(parent, a);
+    b = find(parent, b);
+    if (a == b)
+      return;
+    if (a < b)
+      std::swap(a, b);
+
+    // a is the larger root; it only gets linked if it is still a root
+    std::uint32_t expected = a;
+    if (parent[a].compare_exchange_strong(expected, b,
+                                          std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+void ConnectedComponents::run(const CompressedAdjacency &adjacency,
+                              const std::vector<std::uint8_t> *present) {
+  const auto start = std::chrono::steady_clock::now();
+  const std::size_t vertexCount = adjacency.getVertexCount();
+
+  std::unique_ptr<Parent[]> parent(new Parent[vertexCount]);
+  m_labels.assign(vertexCount, -1);
+
+  // Split vertices evenly; small graphs stay on the calling thread
+  unsigned int threads = m_threads;
+  if (vertexCount < ALGO_CONFIG::MIN_VERTICES_PER_THREAD * 2) {
+    threads = 1;
+  }
+  const std::size_t chunk = (vertexCount + threads - 1) / threads;
+  auto parallelFor = [&](auto &&body) {
+    if (threads == 1) {
+      body(0, vertexCount);
+      return;
+    }
+    std::vector<std::thread> workers;
+    for (std::size_t begin = 0; begin < vertexCount; begin += chunk) {
+      workers.emplace_back(body, begin, std::min(vertexCount, begin + chunk));
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  };
+
+  parallelFor([&](std::size_t begin, std::size_t end) {
+    for (std::size_t v = begin; v < end; ++v) {
+      parent[v].store(static_cast<std::uint32_t>(v),
+                      std::memory_order_relaxed);
+    }
+  });
+
+  // Each undirected edge is listed at both endpoints; only the u < v copy
+  // is united
+  parallelFor([&](std::size_t begin, std::size_t end) {
+    for (std::size_t v = begin; v < end; ++v) {
+      const auto vertex = static_cast<std::uint32_t>(v);
+      for (int neighborId : adjacency.neighbors(static_cast<int>(v))) {
+        const auto neighbor = static_cast<std::uint32_t>(neighborId);
+        if (neighbor > vertex) {
+          unite(parent.get(), vertex, neighbor);
+        }
+      }
+    }
+  });
+
+  // Flatten to roots in parallel, then number components in one ordered
+  // pass. A root is its component's smallest id, so it has always been
+  // numbered by the time its other members are reached.
+  parallelFor([&](std::size_t begin, std::size_t end) {
+    for (std::size_t v = begin; v < end; ++v) {
+      m_labels[v] =
+          static_cast<int>(find(parent.get(), static_cast<std::uint32_t>(v)));
+    }
+  });
+
+  m_sizes.clear();
+  for (std::size_t v = 0; v < vertexCount; ++v) {
+    if (present && !(*present)[v]) {
+      m_labels[v] = -1;
+      continue;
+    }
+    const auto root = static_cast<std::size_t>(m_labels[v]);
+    if (root == v) {
+      m_labels[v] = static_cast<int>(m_sizes.size());
+      m_sizes.push_back(0);
+    } else {
+      m_labels[v] = m_labels[root];
+    }
+    ++m_sizes[m_labels[v]];
+  }
+
+  m_micros = std::chrono::duration<double, std::micro>(
+                 std::chrono::steady_clock::now() - start)
+                 .count();
+}
+
+int ConnectedComponents::getComponent(int vertex) const {
+  if (vertex < 0 || vertex >= static_cast<int>(m_labels.size()))
+    return -1;
+  return m_labels[vertex];
+}
+
+std::size_t ConnectedComponents::getLargestSize() const {
+  if (m_sizes.empty())
+    return 0;
+  return *std::max_element(m_sizes.begin(), m_sizes.end());
+}
@@ -0,0 +1,205 @@
+#include "CullingBenchmark.h"
+#include "Config.h"
+#include "Graph.h"
+#include "Philox.h"
+#include "SpatialIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+constexpr std::size_t HEATMAP_CHECK_STRIDE = 7;
+
+// Chains of nearby nodes with occasional jumps, linked along the chain and
+// by a few random (mostly long) edges
+void buildRandomGraph(Graph &graph, Philox4x32 &rng) {
+  const int nodes = rng.uniformInt(1, 4000);
+  const float extent = rng.uniform(500.0f, 200000.0f);
+  const float stride = GRAPH_CONFIG::MIN_NODE_DISTANCE * 2.0f;
+  sf::Vector2f position(rng.uniform(0.0f, extent), rng.uniform(0.0f, extent));
+  for (int id = 0; id < nodes; ++id) {
+    if (rng.uniformInt(0, 9) == 0) {
+      position = {rng.uniform(0.0f, extent), rng.uniform(0.0f, extent)};
+    } else {
+      position += {rng.uniform(-stride, stride), rng.uniform(-stride, stride)};
+    }
+    graph.addNode(id, position);
+    if (id > 0)
+      graph.addEdge(id - 1, id);
+    if (id > 1 && rng.uniformInt(0, 9) == 0)
+      graph.addEdge(rng.uniformInt(0, id - 2), id);
+  }
+}
+
+bool discIntersects(sf::Vector2f centre, float radius,
+                    const sf::FloatRect &area) {
+  const float x = std::clamp(centre.x, area.position.x,
+                             area.position.x + area.size.x);
+  const float y = std::clamp(centre.y, area.position.y,
+                             area.position.y + area.size.y);
+  const float dx = centre.x - x;
+  const float dy = centre.y - y;
+  return dx * dx + dy * dy <= radius * radius;
+}
+
+bool boxIntersects(sf::Vector2f a, sf::Vector2f b, const sf::FloatRect &area) {
+  return std::min(a.x, b.x) <= area.position.x + area.size.x &&
+         area.position.x <= std::max(a.x, b.x) &&
+         std::min(a.y, b.y) <= area.position.y + area.size.y &&
+         area.position.y <= std::max(a.y, b.y);
+}
+
+// Compares one query against the brute-force answer from current positions
+bool checkView(const Graph &graph, const SpatialIndex &index,
+               const sf::FloatRect &area, bool exactEdges,
+               std::vector<int> &nodes, std::vector<int> &sample,
+               std::vector<std::pair<int, int>> &edges,
+               std::vector<std::uint8_t> &seen, double &queryMicros) {
+  auto start = Clock::now();
+  index.query(area, nodes, edges);
+  queryMicros +=
+      std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+  // The heatmap's count and subsample must agree with the full query
+  if (index.countNodes(area) != nodes.size()) {
+    std::cerr << "countNodes disagrees with queryNodes" << std::endl;
+    return false;
+  }
+  const std::size_t stride = HEATMAP_CHECK_STRIDE;
+  index.sampleNodes(area, stride, sample);
+  for (std::size_t i = 0; i < sample.size(); ++i) {
+    if (sample[i] != nodes[i * stride]) {
+      std::cerr << "sampleNodes disagrees with queryNodes" << std::endl;
+      return false;
+    }
+  }
+  if (sample.size() != (nodes.size() + stride - 1) / stride) {
+    std::cerr << "sampleNodes returned " << sample.size() << " nodes"
+              << std::endl;
+    return false;
+  }
+
+  const float radius =
+      NODE_CONFIG::BASE_RADIUS + NODE_CONFIG::SELECTED_OUTLINE_THICKNESS;
+  seen.assign(graph.getNodes().size(), 0);
+  for (int id : nodes) {
+    if (seen[id]++) {
+      std::cerr << "Node " << id << " returned twice" << std::endl;
+      return false;
+    }
+  }
+  for (const auto &[id, node] : graph.getNodes()) {
+    if (!seen[id] && discIntersects(node->getPosition(), radius, area)) {
+      std::cerr << "Visible node " << id << " missed" << std::endl;
+      return false;
+    }
+  }
+
+  std::sort(edges.begin(), edges.end());
+  if (std::adjacent_find(edges.begin(), edges.end()) != edges.end()) {
+    std::cerr << "Edge returned twice" << std::endl;
+    return false;
+  }
+  std::size_t visibleEdges = 0;
+  for (const auto &[id, node] : graph.getNodes()) {
+    for (int neighborId : node->getNeighbors()) {
+      if (neighborId < id)
+        continue;
+      if (!boxIntersects(node->getPosition(),
+                         graph.getNode(neighborId)->getPosition(), area))
+        continue;
+      ++visibleEdges;
+      if (!std::binary_search(edges.begin(), edges.end(),
+                              std::make_pair(id, neighborId))) {
+        std::cerr << "Visible edge " << id << "-" << neighborId << " missed"
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  if (exactEdges && visibleEdges != edges.size()) {
+    std::cerr << "Hidden edges returned" << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+CullingBenchmark::CullingBenchmark(CullingBenchmarkOptions options)
+    : m_options(options) {}
+
+bool CullingBenchmark::run() {
+  Philox4x32 rng(m_options.seed);
+  std::vector<int> nodes, sample;
+  std::vector<std::pair<int, int>> edges;
+  std::vector<std::uint8_t> seen;
+  double buildMicros = 0.0;
+  double queryMicros = 0.0;
+  std::size_t totalNodes = 0;
+  std::size_t queries = 0;
+
+  for (int g = 0; g < m_options.graphs; ++g) {
+    Graph graph;
+    buildRandomGraph(graph, rng);
+    totalNodes += graph.getNodes().size();
+
+    SpatialIndex index;
+    auto start = Clock::now();
+    index.build(graph);
+    buildMicros += std::chrono::duration<double, std::micro>(Clock::now() -
+                                                             start)
+                       .count();
+
+    // Views around the graph's bounds, from a fraction of a cell to larger
+    // than the whole graph
+    sf::Vector2f lo = graph.getNode(0)->getPosition();
+    sf::Vector2f hi = lo;
+    for (const auto &[id, node] : graph.getNodes()) {
+      lo = {std::min(lo.x, node->getPosition().x),
+            std::min(lo.y, node->getPosition().y)};
+      hi = {std::max(hi.x, node->getPosition().x),
+            std::max(hi.y, node->getPosition().y)};
+    }
+    const sf::Vector2f extent = hi - lo + sf::Vector2f(1.0f, 1.0f);
+    auto randomView = [&]() {
+      sf::Vector2f size(rng.uniform(10.0f, extent.x * 1.5f),
+                        rng.uniform(10.0f, extent.y * 1.5f));
+      sf::Vector2f corner(rng.uniform(lo.x - size.x, hi.x + extent.x * 0.1f),
+                          rng.uniform(lo.y - size.y, hi.y + extent.y * 0.1f));
+      return sf::FloatRect(corner, size);
+    };
+
+    for (int v = 0; v < m_options.viewsPerGraph; ++v, ++queries) {
+      if (!checkView(graph, index, randomView(), true, nodes, sample, edges,
+                     seen, queryMicros))
+        return false;
+    }
+
+    // Jitter every node by at most `drift` without rebuilding
+    const float drift =
+        rng.uniform(0.0f, 2.0f * GRAPH_CONFIG::SPATIAL_CELL_SIZE);
+    for (const auto &[id, node] : graph.getNodes()) {
+      sf::Vector2f d(rng.uniform(-1.0f, 1.0f), rng.uniform(-1.0f, 1.0f));
+      d *= drift / 1.5f; // Keeps |d| below drift
+      node->setPosition(node->getPosition() + d);
+    }
+    index.addDrift(drift);
+    for (int v = 0; v < m_options.viewsPerGraph; ++v, ++queries) {
+      if (!checkView(graph, index, randomView(), false, nodes, sample, edges,
+                     seen, queryMicros))
+        return false;
+    }
+  }
+
+  std::cout << queries << " views over " << m_options.graphs
+            << " random graphs (" << totalNodes << " nodes, seed "
+            << m_options.seed << ") match brute-force visibility"
+            << std::endl;
+  std::cout << "  build: " << buildMicros / m_options.graphs
+            << " us per graph, query: " << queryMicros / queries
+            << " us per view" << std::endl;
+  return true;
+}
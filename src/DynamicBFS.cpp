@@ -0,0 +1,281 @@
+#include "DynamicBFS.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <queue>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double microsSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+      .count();
+}
+} // namespace
+
+DynamicBFS::DynamicBFS(const Graph &graph)
+    : m_graph(graph), m_source(UNREACHED), m_reachable(0),
+      m_reachableWork(0), m_microsPerWork(0.0) {}
+
+void DynamicBFS::setSource(int source) {
+  m_source = source;
+  recompute();
+}
+
+void DynamicBFS::clear() {
+  m_source = UNREACHED;
+  m_reachable = 0;
+  m_reachableWork = 0;
+  m_distance.clear();
+  m_parent.clear();
+  m_distanceCounts.clear();
+  m_report = RepairReport();
+}
+
+int DynamicBFS::getDistance(int id) const {
+  return (id >= 0 && id < static_cast<int>(m_distance.size()))
+             ? m_distance[id]
+             : UNREACHED;
+}
+
+int DynamicBFS::getParent(int id) const {
+  return (id >= 0 && id < static_cast<int>(m_parent.size())) ? m_parent[id]
+                                                             : UNREACHED;
+}
+
+int DynamicBFS::getMaxDistance() const {
+  return std::max(0, static_cast<int>(m_distanceCounts.size()) - 1);
+}
+
+void DynamicBFS::setDistance(int id, int distance) {
+  if (m_distance[id] != UNREACHED) {
+    --m_distanceCounts[m_distance[id]];
+  }
+  m_distance[id] = distance;
+  if (distance != UNREACHED) {
+    if (distance >= static_cast<int>(m_distanceCounts.size())) {
+      m_distanceCounts.resize(distance + 1, 0);
+    }
+    ++m_distanceCounts[distance];
+  }
+  while (!m_distanceCounts.empty() && m_distanceCounts.back() == 0) {
+    m_distanceCounts.pop_back();
+  }
+}
+
+void DynamicBFS::ensureCapacity(int id) {
+  if (id >= static_cast<int>(m_distance.size())) {
+    m_distance.resize(id + 1, UNREACHED);
+    m_parent.resize(id + 1, UNREACHED);
+  }
+}
+
+void DynamicBFS::markReached(int id) {
+  ++m_reachable;
+  m_reachableWork += 1 + m_graph.getNode(id)->getNeighbors().size();
+}
+
+void DynamicBFS::markUnreached(int id) {
+  --m_reachable;
+  m_reachableWork -= 1 + m_graph.getNode(id)->getNeighbors().size();
+}
+
+void DynamicBFS::recompute() {
+  auto start = Clock::now();
+  int maxId = -1;
+  for (const auto &[id, node] : m_graph.getNodes()) {
+    maxId = std::max(maxId, id);
+  }
+  m_distance.assign(maxId + 1, UNREACHED);
+  m_parent.assign(maxId + 1, UNREACHED);
+  m_distanceCounts.clear();
+  m_reachable = 0;
+  m_reachableWork = 0;
+
+  size_t work = 0;
+  if (m_graph.getNode(m_source)) {
+    std::queue<int> queue;
+    queue.push(m_source);
+    setDistance(m_source, 0);
+    while (!queue.empty()) {
+      int current = queue.front();
+      queue.pop();
+      markReached(current);
+      ++work;
+      for (int neighborId : m_graph.getNode(current)->getNeighbors()) {
+        ++work;
+        if (m_distance[neighborId] == UNREACHED) {
+          setDistance(neighborId, m_distance[current] + 1);
+          m_parent[neighborId] = current;
+          queue.push(neighborId);
+        }
+      }
+    }
+  }
+
+  m_report = RepairReport();
+  m_report.repairWork = work;
+  m_report.affectedVertices = m_reachable;
+  m_report.repairMicros = m_report.fullMicros = microsSince(start);
+  m_report.fullWork = work;
+  m_microsPerWork = work > 0 ? m_report.fullMicros / work : 0.0;
+}
+
+const RepairReport &DynamicBFS::edgeInserted(int u, int v) {
+  auto start = Clock::now();
+  ensureCapacity(std::max(u, v));
+  size_t work = 0;
+  size_t affected = 0;
+
+  // The new list entries count towards already-reachable endpoints
+  for (int endpoint : {u, v}) {
+    if (isFinite(endpoint))
+      ++m_reachableWork;
+  }
+
+  // Orient so u is the endpoint closer to the source
+  if (!isFinite(u) || (isFinite(v) && m_distance[v] < m_distance[u])) {
+    std::swap(u, v);
+  }
+
+  // Only a strict shortcut changes anything; propagate the decrease outward
+  if (isFinite(u) && (!isFinite(v) || m_distance[u] + 1 < m_distance[v])) {
+    if (!isFinite(v))
+      markReached(v);
+    setDistance(v, m_distance[u] + 1);
+    m_parent[v] = u;
+
+    std::queue<int> queue;
+    queue.push(v);
+    while (!queue.empty()) {
+      int current = queue.front();
+      queue.pop();
+      ++affected;
+      ++work;
+      for (int neighborId : m_graph.getNode(current)->getNeighbors()) {
+        ++work;
+        ensureCapacity(neighborId);
+        int candidate = m_distance[current] + 1;
+        if (!isFinite(neighborId) || candidate < m_distance[neighborId]) {
+          if (!isFinite(neighborId))
+            markReached(neighborId);
+          setDistance(neighborId, candidate);
+          m_parent[neighborId] = current;
+          queue.push(neighborId);
+        }
+      }
+    }
+  }
+
+  m_report.affectedVertices = affected;
+  finishReport(work, microsSince(start));
+  return m_report;
+}
+
+const RepairReport &DynamicBFS::edgeDeleted(int u, int v) {
+  auto start = Clock::now();
+  ensureCapacity(std::max(u, v));
+  size_t work = 0;
+
+  for (int endpoint : {u, v}) {
+    if (isFinite(endpoint))
+      --m_reachableWork;
+  }
+
+  // Removing a non-tree edge never changes BFS distances
+  int child = UNREACHED;
+  if (m_parent[v] == u) {
+    child = v;
+  } else if (m_parent[u] == v) {
+    child = u;
+  }
+  if (child == UNREACHED) {
+    m_report.affectedVertices = 0;
+    finishReport(work, microsSince(start));
+    return m_report;
+  }
+
+  // Fast path: another neighbor one level up can adopt the child unchanged
+  for (int neighborId : m_graph.getNode(child)->getNeighbors()) {
+    ++work;
+    if (isFinite(neighborId) &&
+        m_distance[neighborId] + 1 == m_distance[child]) {
+      m_parent[child] = neighborId;
+      m_report.affectedVertices = 0;
+      finishReport(work, microsSince(start));
+      return m_report;
+    }
+  }
+
+  // Collect the subtree hanging off the deleted tree edge; only these
+  // vertices can have moved further away
+  std::vector<int> affected{child};
+  for (size_t i = 0; i < affected.size(); ++i) {
+    int current = affected[i];
+    ++work;
+    for (int neighborId : m_graph.getNode(current)->getNeighbors()) {
+      ++work;
+      if (m_parent[neighborId] == current) {
+        affected.push_back(neighborId);
+      }
+    }
+  }
+  for (int id : affected) {
+    markUnreached(id);
+    setDistance(id, UNREACHED);
+    m_parent[id] = UNREACHED;
+  }
+
+  // Re-seed each affected vertex from its best unaffected neighbor, then
+  // settle the region in distance order (unit weights, so a min-heap keyed
+  // by tentative distance reproduces BFS order)
+  using Entry = std::pair<int, int>; // (distance, id)
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+  for (int id : affected) {
+    for (int neighborId : m_graph.getNode(id)->getNeighbors()) {
+      ++work;
+      if (isFinite(neighborId) &&
+          (!isFinite(id) || m_distance[neighborId] + 1 < m_distance[id])) {
+        setDistance(id, m_distance[neighborId] + 1);
+        m_parent[id] = neighborId;
+      }
+    }
+    if (isFinite(id)) {
+      heap.emplace(m_distance[id], id);
+    }
+  }
+
+  while (!heap.empty()) {
+    auto [distance, current] = heap.top();
+    heap.pop();
+    if (distance != m_distance[current])
+      continue; // Stale entry
+    ++work;
+    for (int neighborId : m_graph.getNode(current)->getNeighbors()) {
+      ++work;
+      if (!isFinite(neighborId) || distance + 1 < m_distance[neighborId]) {
+        setDistance(neighborId, distance + 1);
+        m_parent[neighborId] = current;
+        heap.emplace(distance + 1, neighborId);
+      }
+    }
+  }
+
+  for (int id : affected) {
+    if (isFinite(id))
+      markReached(id);
+  }
+
+  m_report.affectedVertices = affected.size();
+  finishReport(work, microsSince(start));
+  return m_report;
+}
+
+void DynamicBFS::finishReport(size_t work, double micros) {
+  m_report.repairWork = work;
+  m_report.repairMicros = micros;
+
+  // A full recompute would settle every reachable vertex and scan its list
+  m_report.fullWork = m_reachableWork;
+  m_report.fullMicros = m_reachableWork * m_microsPerWork;
+}
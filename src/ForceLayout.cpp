@@ -0,0 +1,277 @@
+#include "ForceLayout.h"
+#include "Config.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <unordered_map>
+
+ForceLayout::ForceLayout(Graph &graph)
+    : m_graph(graph), m_enabled(false),
+      m_temperature(LAYOUT_CONFIG::INITIAL_TEMPERATURE) {}
+
+void ForceLayout::setEnabled(bool enable) {
+  m_enabled = enable;
+  if (enable) {
+    restart();
+  }
+}
+
+bool ForceLayout::isSettled() const {
+  return m_temperature <= LAYOUT_CONFIG::MIN_TEMPERATURE;
+}
+
+void ForceLayout::restart() {
+  m_temperature = LAYOUT_CONFIG::INITIAL_TEMPERATURE;
+}
+
+float ForceLayout::step() {
+  if (!m_enabled || isSettled())
+    return 0.0f;
+
+  snapshotGraph();
+  if (m_positions.empty())
+    return 0.0f;
+
+  buildQuadtree();
+
+  // Repulsion dominates the cost; split bodies across cores once there are
+  // enough of them to amortise thread startup
+  const size_t bodyCount = m_positions.size();
+  unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+  if (bodyCount < LAYOUT_CONFIG::MIN_BODIES_PER_THREAD * 2) {
+    threads = 1;
+  }
+
+  if (threads == 1) {
+    computeRepulsion(0, bodyCount);
+  } else {
+    std::vector<std::thread> workers;
+    size_t chunk = (bodyCount + threads - 1) / threads;
+    for (size_t begin = 0; begin < bodyCount; begin += chunk) {
+      size_t end = std::min(bodyCount, begin + chunk);
+      workers.emplace_back(&ForceLayout::computeRepulsion, this, begin, end);
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  applyAttraction();
+
+  // Gravity keeps disconnected components from drifting to the boundaries
+  const sf::Vector2f center(GRAPH_CONFIG::getCenterX(),
+                            GRAPH_CONFIG::getCenterY());
+  for (size_t i = 0; i < bodyCount; ++i) {
+    m_displacements[i] += (center - m_positions[i]) * LAYOUT_CONFIG::GRAVITY;
+  }
+
+  // Move each node by at most the current temperature. Clamping can move a
+  // node that started outside the bounds further, so the actual largest
+  // move is measured for the caller.
+  float largestMoveSquared = 0.0f;
+  for (size_t i = 0; i < bodyCount; ++i) {
+    sf::Vector2f d = m_displacements[i];
+    float length = std::sqrt(d.x * d.x + d.y * d.y);
+    if (length > 0.0f) {
+      d *= std::min(length, m_temperature) / length;
+    }
+    sf::Vector2f position = m_graph.clampToBounds(m_positions[i] + d);
+    sf::Vector2f moved = position - m_positions[i];
+    largestMoveSquared =
+        std::max(largestMoveSquared, moved.x * moved.x + moved.y * moved.y);
+    m_graph.getNode(m_ids[i])->setPosition(position);
+  }
+
+  m_temperature *= LAYOUT_CONFIG::COOLING_FACTOR;
+  return std::sqrt(largestMoveSquared);
+}
+
+void ForceLayout::snapshotGraph() {
+  const auto &nodes = m_graph.getNodes();
+  m_ids.clear();
+  m_positions.clear();
+  m_edges.clear();
+
+  std::unordered_map<int, int> indexOf;
+  indexOf.reserve(nodes.size());
+  for (const auto &[id, node] : nodes) {
+    indexOf[id] = static_cast<int>(m_ids.size());
+    m_ids.push_back(id);
+    m_positions.push_back(node->getPosition());
+  }
+
+  for (const auto &[id, node] : nodes) {
+    for (int neighborId : node->getNeighbors()) {
+      if (id < neighborId) {
+        m_edges.emplace_back(indexOf[id], indexOf.at(neighborId));
+      }
+    }
+  }
+
+  m_displacements.assign(m_positions.size(), sf::Vector2f(0.0f, 0.0f));
+}
+
+void ForceLayout::buildQuadtree() {
+  sf::Vector2f lo = m_positions.front();
+  sf::Vector2f hi = lo;
+  for (const auto &pos : m_positions) {
+    lo.x = std::min(lo.x, pos.x);
+    lo.y = std::min(lo.y, pos.y);
+    hi.x = std::max(hi.x, pos.x);
+    hi.y = std::max(hi.y, pos.y);
+  }
+
+  m_cells.clear();
+  m_cells.reserve(m_positions.size() * 2);
+  m_nextInLeaf.assign(m_positions.size(), -1);
+  float halfSize = std::max(hi.x - lo.x, hi.y - lo.y) / 2.0f + 1.0f;
+  createCell((lo + hi) / 2.0f, halfSize);
+
+  for (size_t body = 0; body < m_positions.size(); ++body) {
+    insertBody(0, static_cast<int>(body), 0);
+  }
+
+  // Turn accumulated weighted sums into centres of mass
+  for (auto &cell : m_cells) {
+    if (cell.mass > 0.0f) {
+      cell.centerOfMass /= cell.mass;
+    }
+  }
+}
+
+int ForceLayout::createCell(sf::Vector2f center, float halfSize) {
+  m_cells.push_back(Cell{center, halfSize, {0.0f, 0.0f}, 0.0f, -1,
+                         {-1, -1, -1, -1}});
+  return static_cast<int>(m_cells.size()) - 1;
+}
+
+void ForceLayout::insertBody(int cellIndex, int body, int depth) {
+  const sf::Vector2f pos = m_positions[body];
+
+  while (true) {
+    // Note: m_cells may reallocate below, so re-fetch the cell every pass
+    m_cells[cellIndex].centerOfMass += pos;
+    m_cells[cellIndex].mass += 1.0f;
+
+    const bool isLeaf = m_cells[cellIndex].children[0] == -1 &&
+                        m_cells[cellIndex].children[1] == -1 &&
+                        m_cells[cellIndex].children[2] == -1 &&
+                        m_cells[cellIndex].children[3] == -1;
+
+    if (isLeaf && m_cells[cellIndex].mass == 1.0f) {
+      m_cells[cellIndex].body = body;
+      return;
+    }
+
+    // Coincident points would recurse forever; let them share a leaf
+    if (depth >= LAYOUT_CONFIG::MAX_QUADTREE_DEPTH) {
+      m_nextInLeaf[body] = m_cells[cellIndex].body;
+      m_cells[cellIndex].body = body;
+      return;
+    }
+
+    // Push an existing single body down before descending
+    if (isLeaf) {
+      int existing = m_cells[cellIndex].body;
+      m_cells[cellIndex].body = -1;
+      if (existing != -1) {
+        sf::Vector2f existingPos = m_positions[existing];
+        sf::Vector2f c = m_cells[cellIndex].center;
+        float h = m_cells[cellIndex].halfSize / 2.0f;
+        int quadrant = (existingPos.x >= c.x ? 1 : 0) |
+                       (existingPos.y >= c.y ? 2 : 0);
+        int child = createCell(
+            {c.x + (quadrant & 1 ? h : -h), c.y + (quadrant & 2 ? h : -h)}, h);
+        m_cells[cellIndex].children[quadrant] = child;
+        m_cells[child].centerOfMass = existingPos;
+        m_cells[child].mass = 1.0f;
+        m_cells[child].body = existing;
+      }
+    }
+
+    sf::Vector2f c = m_cells[cellIndex].center;
+    float h = m_cells[cellIndex].halfSize / 2.0f;
+    int quadrant = (pos.x >= c.x ? 1 : 0) | (pos.y >= c.y ? 2 : 0);
+    if (m_cells[cellIndex].children[quadrant] == -1) {
+      int child = createCell(
+          {c.x + (quadrant & 1 ? h : -h), c.y + (quadrant & 2 ? h : -h)}, h);
+      m_cells[cellIndex].children[quadrant] = child;
+    }
+    cellIndex = m_cells[cellIndex].children[quadrant];
+    ++depth;
+  }
+}
+
+void ForceLayout::computeRepulsion(size_t begin, size_t end) {
+  for (size_t body = begin; body < end; ++body) {
+    m_displacements[body] += repulsionOn(static_cast<int>(body));
+  }
+}
+
+sf::Vector2f ForceLayout::repulsionOn(int body) const {
+  const float k = LAYOUT_CONFIG::IDEAL_EDGE_LENGTH;
+  const float thetaSquared = LAYOUT_CONFIG::THETA * LAYOUT_CONFIG::THETA;
+  const sf::Vector2f pos = m_positions[body];
+  sf::Vector2f force(0.0f, 0.0f);
+
+  // Explicit stack; the tree is at most MAX_QUADTREE_DEPTH deep
+  int stack[4 * LAYOUT_CONFIG::MAX_QUADTREE_DEPTH + 4];
+  int top = 0;
+  stack[top++] = 0;
+
+  while (top > 0) {
+    const Cell &cell = m_cells[stack[--top]];
+    if (cell.mass == 0.0f)
+      continue;
+
+    // Leaves repel body by body, so a body sharing a depth-capped leaf is
+    // pushed by the others in it and never by itself
+    bool isLeaf = cell.children[0] == -1 && cell.children[1] == -1 &&
+                  cell.children[2] == -1 && cell.children[3] == -1;
+    if (isLeaf) {
+      for (int other = cell.body; other != -1; other = m_nextInLeaf[other]) {
+        if (other == body)
+          continue;
+        sf::Vector2f delta = pos - m_positions[other];
+        float distSquared = std::max(delta.x * delta.x + delta.y * delta.y,
+                                     LAYOUT_CONFIG::MIN_DISTANCE_SQUARED);
+        force += delta * (k * k / distSquared);
+      }
+      continue;
+    }
+
+    sf::Vector2f delta = pos - cell.centerOfMass;
+    float distSquared = std::max(delta.x * delta.x + delta.y * delta.y,
+                                 LAYOUT_CONFIG::MIN_DISTANCE_SQUARED);
+    float width = cell.halfSize * 2.0f;
+
+    // Far enough away (width / distance < theta): treat as one mass
+    if (width * width < thetaSquared * distSquared) {
+      // Fruchterman-Reingold repulsion k^2 / d along delta / d
+      force += delta * (cell.mass * k * k / distSquared);
+      continue;
+    }
+
+    for (int child : cell.children) {
+      if (child != -1) {
+        stack[top++] = child;
+      }
+    }
+  }
+  return force;
+}
+
+void ForceLayout::applyAttraction() {
+  const float k = LAYOUT_CONFIG::IDEAL_EDGE_LENGTH;
+  for (const auto &[a, b] : m_edges) {
+    sf::Vector2f delta = m_positions[a] - m_positions[b];
+    float dist = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    if (dist <= 0.0f)
+      continue;
+
+    // Fruchterman-Reingold attraction d^2 / k along delta / d
+    sf::Vector2f pull = delta * (dist / k);
+    m_displacements[a] -= pull;
+    m_displacements[b] += pull;
+  }
+}
@@ -0,0 +1,58 @@
+#include "FramePool.h"
+#include <new>
+
+FramePool::FreeLists::~FreeLists() {
+  for (FreeBlock *&head : heads) {
+    while (head) {
+      FreeBlock *next = head->next;
+      ::operator delete(head);
+      head = next;
+    }
+  }
+}
+
+FramePool::FreeLists &FramePool::freeLists() {
+  thread_local FreeLists lists;
+  return lists;
+}
+
+std::size_t FramePool::sizeClass(std::size_t size) {
+  std::size_t shift = MIN_CLASS_SHIFT;
+  while ((std::size_t{1} << shift) < size)
+    ++shift;
+  return shift - MIN_CLASS_SHIFT;
+}
+
+void *FramePool::allocate(std::size_t size) {
+  FreeLists &lists = freeLists();
+  std::size_t index = sizeClass(size);
+  if (index >= CLASS_COUNT) {
+    ++lists.systemAllocations;
+    return ::operator new(size);
+  }
+
+  if (FreeBlock *block = lists.heads[index]) {
+    lists.heads[index] = block->next;
+    return block;
+  }
+
+  ++lists.systemAllocations;
+  return ::operator new(std::size_t{1} << (index + MIN_CLASS_SHIFT));
+}
+
+void FramePool::deallocate(void *frame, std::size_t size) noexcept {
+  std::size_t index = sizeClass(size);
+  if (index >= CLASS_COUNT) {
+    ::operator delete(frame);
+    return;
+  }
+
+  FreeLists &lists = freeLists();
+  auto *block = static_cast<FreeBlock *>(frame);
+  block->next = lists.heads[index];
+  lists.heads[index] = block;
+}
+
+std::size_t FramePool::getSystemAllocations() {
+  return freeLists().systemAllocations;
+}
@@ -1,8 +1,13 @@
 #include "Graph.h"
 #include "Config.h"
+#include "Snapshot.h"
+#include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
-#include <random>
+#include <limits>
+#include <sstream>
 
 Graph::Graph() = default;
 
@@ -20,13 +25,197 @@ void Graph::addEdge(int from, int to) {
   }
 }
 
+void Graph::removeEdge(int from, int to) {
+  auto fromNode = getNode(from);
+  auto toNode = getNode(to);
+
+  if (fromNode && toNode) {
+    fromNode->removeNeighbor(to);
+    toNode->removeNeighbor(from);
+  }
+}
+
+void Graph::removeNode(int id) {
+  auto node = getNode(id);
+  if (!node)
+    return;
+
+  for (int neighborId : node->getNeighbors()) {
+    if (auto neighbor = getNode(neighborId)) {
+      neighbor->removeNeighbor(id);
+    }
+  }
+  m_nodes.erase(id);
+}
+
+bool Graph::hasEdge(int from, int to) const {
+  auto fromNode = getNode(from);
+  return fromNode && fromNode->hasNeighbor(to);
+}
+
+int Graph::getNextId() const {
+  int nextId = 0;
+  for (const auto &[id, node] : m_nodes) {
+    nextId = std::max(nextId, id + 1);
+  }
+  return nextId;
+}
+
 void Graph::clear() { m_nodes.clear(); }
 
+void Graph::relabel(const std::vector<int> &order) {
+  std::vector<int> newIdOf(getNextId(), -1);
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    newIdOf[order[i]] = static_cast<int>(i);
+  }
+
+  std::unordered_map<int, NodePtr> relabelled;
+  relabelled.reserve(order.size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    const Node &node = *m_nodes.at(order[i]);
+    std::vector<int> neighbors;
+    neighbors.reserve(node.getNeighbors().size());
+    for (int neighborId : node.getNeighbors()) {
+      neighbors.push_back(newIdOf[neighborId]);
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+
+    auto moved = std::make_shared<Node>(node);
+    moved->setId(static_cast<int>(i));
+    moved->setNeighbors(std::move(neighbors));
+    relabelled.emplace(static_cast<int>(i), std::move(moved));
+  }
+
+  m_nodes = std::move(relabelled);
+}
+
+void Graph::save(std::ostream &out) const {
+  // Emit in id order so identical graphs produce identical files
+  std::vector<int> ids;
+  ids.reserve(m_nodes.size());
+  for (const auto &[id, node] : m_nodes) {
+    ids.push_back(id);
+  }
+  std::sort(ids.begin(), ids.end());
+
+  // Enough digits for positions to round-trip exactly through loadFromFile
+  std::streamsize oldPrecision = out.precision(9);
+  out << "# nodes " << ids.size() << "\n";
+  for (int id : ids) {
+    const Node &node = *m_nodes.at(id);
+    sf::Vector2f pos = node.getPosition();
+    out << "v " << id << ' ' << pos.x << ' ' << pos.y;
+    if (node.getLabel() != id) { // Keep the pre-reordering id
+      out << ' ' << node.getLabel();
+    }
+    out << "\n";
+  }
+  for (int id : ids) {
+    for (int neighborId : m_nodes.at(id)->getNeighbors()) {
+      if (id < neighborId) { // Undirected: write each edge once
+        out << "e " << id << ' ' << neighborId << "\n";
+      }
+    }
+  }
+  out.precision(oldPrecision);
+}
+
+bool Graph::loadFromFile(const std::string &path) {
+  std::ifstream in(path);
+  if (!in) {
+    std::cerr << "Could not open graph file: " << path << "\n";
+    return false;
+  }
+
+  // Discards what was read so far and starts a "path:line: " message
+  auto fail = [&](int lineNumber) -> std::ostream & {
+    clear();
+    return std::cerr << path << ":" << lineNumber << ": ";
+  };
+
+  // Dense per-vertex arrays downstream are sized by the largest id, so ids
+  // must be non-negative, unique and bounded. Edges are checked once every
+  // vertex is known, so they may precede their endpoints in the file.
+  struct EdgeLine {
+    int from;
+    int to;
+    int lineNumber;
+  };
+  std::vector<EdgeLine> edges;
+  std::unordered_map<int, int> declaredOn; // Vertex id -> line
+
+  clear();
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(in, line)) {
+    ++lineNumber;
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::istringstream fields(line);
+    char kind = 0;
+    fields >> kind;
+    if (kind == 'v') {
+      int id;
+      float x, y;
+      if (fields >> id >> x >> y) {
+        if (id < 0 || id > GRAPH_CONFIG::MAX_FILE_ID) {
+          fail(lineNumber) << "vertex id " << id << " outside [0, "
+                           << GRAPH_CONFIG::MAX_FILE_ID << "]\n";
+          return false;
+        }
+        auto [it, inserted] = declaredOn.emplace(id, lineNumber);
+        if (!inserted) {
+          fail(lineNumber) << "duplicate vertex " << id << " (first on line "
+                           << it->second << ")\n";
+          return false;
+        }
+        addNode(id, {x, y});
+        int label;
+        if (fields >> label) {
+          getNode(id)->setLabel(label);
+        }
+        continue;
+      }
+    } else if (kind == 'e') {
+      int from, to;
+      if (fields >> from >> to) {
+        if (from == to) {
+          fail(lineNumber) << "self-loop on vertex " << from << "\n";
+          return false;
+        }
+        edges.push_back({from, to, lineNumber});
+        continue;
+      }
+    }
+
+    fail(lineNumber) << "malformed line\n";
+    return false;
+  }
+
+  for (const EdgeLine &edge : edges) {
+    for (int endpoint : {edge.from, edge.to}) {
+      if (!declaredOn.count(endpoint)) {
+        fail(edge.lineNumber) << "edge to unknown vertex " << endpoint
+                              << "\n";
+        return false;
+      }
+    }
+    addEdge(edge.from, edge.to);
+  }
+  return true;
+}
+
 NodePtr Graph::getNode(int id) const {
   auto it = m_nodes.find(id);
   return (it != m_nodes.end()) ? it->second : nullptr;
 }
 
+int Graph::getLabel(int id) const {
+  auto node = getNode(id);
+  return node ? node->getLabel() : id;
+}
+
 int Graph::getNodeAtPosition(sf::Vector2f position) const {
   for (const auto &[id, node] : m_nodes) {
     if (node->contains(position)) {
@@ -53,6 +242,24 @@ void Graph::draw(sf::RenderWindow &window, sf::Font &font) const {
   }
 }
 
+void Graph::draw(sf::RenderWindow &window, sf::Font &font,
+                 const std::vector<std::pair<int, int>> &edges,
+                 const std::vector<int> &nodeIds) const {
+  for (const auto &[from, to] : edges) {
+    auto fromNode = getNode(from);
+    auto toNode = getNode(to);
+    if (fromNode && toNode) {
+      drawEdge(window, *fromNode, *toNode);
+    }
+  }
+
+  for (int id : nodeIds) {
+    if (auto node = getNode(id)) {
+      node->draw(window, font);
+    }
+  }
+}
+
 void Graph::drawEdge(sf::RenderWindow &window, const Node &from,
                      const Node &to) const {
   sf::Vector2f fromPos = from.getPosition();
@@ -84,22 +291,20 @@ void Graph::drawEdge(sf::RenderWindow &window, const Node &from,
   }
 }
 
-void Graph::generateSampleGraph() {
+bool Graph::generateSampleGraph(std::uint64_t seed, std::uint64_t stream,
+                                GenerationProgress *progress) {
   clear();
 
-  // Initialize random number generators
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
-  static std::uniform_int_distribution<int> nodeCountDist(
-      ALGO_CONFIG::MIN_NODES, ALGO_CONFIG::MAX_NODES);
-  static std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159f);
-  static std::uniform_real_distribution<float> radiusDist(
-      GRAPH_CONFIG::getMinRadiusPlacement(),
-      GRAPH_CONFIG::getMaxRadiusPlacement());
-  static std::uniform_real_distribution<float> edgeProbDist(0.0f, 1.0f);
-  static std::uniform_int_distribution<int> connectDist(1, 3);
-
-  int targetNodes = nodeCountDist(gen);
+  auto isCancelled = [progress]() {
+    return progress && progress->cancelled.load(std::memory_order_relaxed);
+  };
+
+  // All randomness comes from one counter-based stream, so generation has no
+  // shared state and is safe to run on any number of threads
+  Philox4x32 rng(seed, stream);
+
+  int targetNodes =
+      rng.uniformInt(ALGO_CONFIG::MIN_NODES, ALGO_CONFIG::MAX_NODES);
   std::vector<sf::Vector2f> positions;
 
   if (GRAPH_CONFIG::DEBUG_PLACEMENT) {
@@ -108,6 +313,9 @@ void Graph::generateSampleGraph() {
 
   // Place nodes using hierarchical strategy
   for (int i = 0; i < targetNodes; ++i) {
+    if (isCancelled())
+      return false;
+
     sf::Vector2f newPos;
     bool positionFound = false;
 
@@ -128,7 +336,7 @@ void Graph::generateSampleGraph() {
       for (int attempt = 0;
            attempt < GRAPH_CONFIG::RING_PLACEMENT_ATTEMPTS && !positionFound;
            ++attempt) {
-        newPos = generateRingPosition(gen, angleDist, radiusDist, edgeProbDist);
+        newPos = generateRingPosition(rng);
         if (isValidPosition(newPos, positions)) {
           positionFound = true;
           if (GRAPH_CONFIG::DEBUG_PLACEMENT) {
@@ -143,7 +351,7 @@ void Graph::generateSampleGraph() {
       for (int attempt = 0;
            attempt < GRAPH_CONFIG::GRID_PLACEMENT_ATTEMPTS && !positionFound;
            ++attempt) {
-        newPos = generateGridPosition(i, targetNodes, edgeProbDist, gen);
+        newPos = generateGridPosition(i, targetNodes, rng);
         if (isValidPosition(newPos, positions)) {
           positionFound = true;
           if (GRAPH_CONFIG::DEBUG_PLACEMENT) {
@@ -158,7 +366,7 @@ void Graph::generateSampleGraph() {
       for (int attempt = 0;
            attempt < GRAPH_CONFIG::RANDOM_PLACEMENT_ATTEMPTS && !positionFound;
            ++attempt) {
-        newPos = generateRandomPosition(gen);
+        newPos = generateRandomPosition(rng);
         if (isValidPosition(newPos, positions)) {
           positionFound = true;
           if (GRAPH_CONFIG::DEBUG_PLACEMENT) {
@@ -187,6 +395,15 @@ void Graph::generateSampleGraph() {
       targetNodes = i; // Reduce target to successfully placed nodes
       break;
     }
+
+    if (progress) {
+      progress->placement.store(static_cast<float>(i + 1) / targetNodes,
+                                std::memory_order_relaxed);
+    }
+  }
+
+  if (progress) {
+    progress->placement.store(1.0f, std::memory_order_relaxed);
   }
 
   // Update numNodes to actual placed count
@@ -203,6 +420,9 @@ void Graph::generateSampleGraph() {
   connected[0] = true;
 
   for (int i = 1; i < actualNodes; ++i) {
+    if (isCancelled())
+      return false;
+
     // Find closest connected node
     int bestTarget = -1;
     float minDistance = std::numeric_limits<float>::max();
@@ -223,11 +443,20 @@ void Graph::generateSampleGraph() {
       addEdge(i, bestTarget);
       connected[i] = true;
     }
+
+    // Spanning tree accounts for the first half of the connectivity phase
+    if (progress) {
+      progress->connectivity.store(0.5f * i / actualNodes,
+                                   std::memory_order_relaxed);
+    }
   }
 
   // Step 2: Add additional edges for interesting structure
   for (int i = 0; i < actualNodes; ++i) {
-    int extraConnections = connectDist(gen);
+    if (isCancelled())
+      return false;
+
+    int extraConnections = rng.uniformInt(1, 3);
 
     for (int attempt = 0; attempt < extraConnections; ++attempt) {
       for (int j = i + 1; j < actualNodes; ++j) {
@@ -254,26 +483,34 @@ void Graph::generateSampleGraph() {
           float probability =
               std::max(0.05f, 0.6f - (distance / maxConnectDistance));
 
-          if (edgeProbDist(gen) < probability) {
+          if (rng.uniform(0.0f, 1.0f) < probability) {
             addEdge(i, j);
             break;
           }
         }
       }
     }
+
+    if (progress) {
+      progress->connectivity.store(0.5f + 0.5f * (i + 1) / actualNodes,
+                                   std::memory_order_relaxed);
+    }
   }
+
+  if (progress) {
+    progress->connectivity.store(1.0f, std::memory_order_relaxed);
+  }
+  return true;
 }
 
-sf::Vector2f Graph::generateRingPosition(
-    std::mt19937 &gen, std::uniform_real_distribution<float> &angleDist,
-    std::uniform_real_distribution<float> &radiusDist,
-    std::uniform_real_distribution<float> &edgeProbDist) const {
+sf::Vector2f Graph::generateRingPosition(Philox4x32 &rng) const {
   const float centerX = GRAPH_CONFIG::getCenterX();
   const float centerY = GRAPH_CONFIG::getCenterY();
 
   // Generate position in ring around center
-  float angle = angleDist(gen);
-  float radius = radiusDist(gen);
+  float angle = rng.uniform(0.0f, 2.0f * 3.14159f);
+  float radius = rng.uniform(GRAPH_CONFIG::getMinRadiusPlacement(),
+                             GRAPH_CONFIG::getMaxRadiusPlacement());
 
   sf::Vector2f newPos;
   newPos.x = centerX + radius * std::cos(angle);
@@ -281,16 +518,14 @@ sf::Vector2f Graph::generateRingPosition(
 
   // Add controlled random offset
   float offsetRange = GRAPH_CONFIG::getRandomOffsetRange();
-  newPos.x += (edgeProbDist(gen) - 0.5f) * offsetRange;
-  newPos.y += (edgeProbDist(gen) - 0.5f) * offsetRange;
+  newPos.x += (rng.uniform(0.0f, 1.0f) - 0.5f) * offsetRange;
+  newPos.y += (rng.uniform(0.0f, 1.0f) - 0.5f) * offsetRange;
 
   return clampToBounds(newPos);
 }
 
-sf::Vector2f
-Graph::generateGridPosition(int nodeIndex, int totalNodes,
-                            std::uniform_real_distribution<float> &edgeProbDist,
-                            std::mt19937 &gen) const {
+sf::Vector2f Graph::generateGridPosition(int nodeIndex, int totalNodes,
+                                         Philox4x32 &rng) const {
   // Calculate grid dimensions
   int gridSize = static_cast<int>(std::ceil(std::sqrt(totalNodes))) + 1;
   int gridX = (nodeIndex - 1) % gridSize; // -1 because node 0 is at center
@@ -304,19 +539,18 @@ Graph::generateGridPosition(int nodeIndex, int totalNodes,
 
   // Add small jitter to avoid perfect alignment
   float jitterRange = spacing * 0.2f; // 20% of spacing
-  newPos.x += (edgeProbDist(gen) - 0.5f) * jitterRange;
-  newPos.y += (edgeProbDist(gen) - 0.5f) * jitterRange;
+  newPos.x += (rng.uniform(0.0f, 1.0f) - 0.5f) * jitterRange;
+  newPos.y += (rng.uniform(0.0f, 1.0f) - 0.5f) * jitterRange;
 
   return clampToBounds(newPos);
 }
 
-sf::Vector2f Graph::generateRandomPosition(std::mt19937 &gen) const {
-  std::uniform_real_distribution<float> xDist(GRAPH_CONFIG::getLeftBoundary(),
-                                              GRAPH_CONFIG::getRightBoundary());
-  std::uniform_real_distribution<float> yDist(
-      GRAPH_CONFIG::getTopBoundary(), GRAPH_CONFIG::getBottomBoundary());
-
-  return sf::Vector2f(xDist(gen), yDist(gen));
+sf::Vector2f Graph::generateRandomPosition(Philox4x32 &rng) const {
+  float x = rng.uniform(GRAPH_CONFIG::getLeftBoundary(),
+                        GRAPH_CONFIG::getRightBoundary());
+  float y = rng.uniform(GRAPH_CONFIG::getTopBoundary(),
+                        GRAPH_CONFIG::getBottomBoundary());
+  return sf::Vector2f(x, y);
 }
 
 bool Graph::isValidPosition(
@@ -342,3 +576,82 @@ sf::Vector2f Graph::clampToBounds(const sf::Vector2f &position) const {
                        std::min(GRAPH_CONFIG::getBottomBoundary(), clamped.y));
   return clamped;
 }
+
+void Graph::writeSnapshot(SnapshotWriter &writer) const {
+  // Hash-map order: sorting would cost the UI thread more than the copy
+  std::vector<std::int32_t> ids, labels, neighbors;
+  std::vector<sf::Vector2f> positions;
+  std::vector<std::uint8_t> flags;
+  std::vector<std::uint64_t> offsets{0};
+  ids.reserve(m_nodes.size());
+  labels.reserve(m_nodes.size());
+  positions.reserve(m_nodes.size());
+  flags.reserve(m_nodes.size());
+  offsets.reserve(m_nodes.size() + 1);
+  for (const auto &[id, node] : m_nodes) {
+    ids.push_back(id);
+    labels.push_back(node->getLabel());
+    positions.push_back(node->getPosition());
+    flags.push_back(node->isTarget() ? 1 : 0);
+    neighbors.insert(neighbors.end(), node->getNeighbors().begin(),
+                     node->getNeighbors().end());
+    offsets.push_back(neighbors.size());
+  }
+
+  writer.add(SnapshotSection::NODE_IDS, std::move(ids));
+  writer.add(SnapshotSection::NODE_LABELS, std::move(labels));
+  writer.add(SnapshotSection::NODE_POSITIONS, std::move(positions));
+  writer.add(SnapshotSection::NODE_FLAGS, std::move(flags));
+  writer.add(SnapshotSection::NEIGHBOR_OFFSETS, std::move(offsets));
+  writer.add(SnapshotSection::NEIGHBORS, std::move(neighbors));
+}
+
+bool Graph::restoreSnapshot(const SnapshotReader &reader) {
+  auto ids = reader.get<std::int32_t>(SnapshotSection::NODE_IDS);
+  auto labels = reader.get<std::int32_t>(SnapshotSection::NODE_LABELS);
+  auto positions = reader.get<sf::Vector2f>(SnapshotSection::NODE_POSITIONS);
+  auto flags = reader.get<std::uint8_t>(SnapshotSection::NODE_FLAGS);
+  auto offsets = reader.get<std::uint64_t>(SnapshotSection::NEIGHBOR_OFFSETS);
+  auto neighbors = reader.get<std::int32_t>(SnapshotSection::NEIGHBORS);
+
+  const std::size_t count = ids.size();
+  if (labels.size() != count || positions.size() != count ||
+      flags.size() != count || offsets.size() != count + 1 ||
+      offsets[0] != 0 || offsets[count] != neighbors.size()) {
+    return false;
+  }
+
+  // Ids must be unique and non-negative, neighbor lists in bounds and every
+  // neighbor an existing node
+  int nextId = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    // INT_MAX would overflow ids[i] + 1
+    if (ids[i] < 0 || ids[i] == std::numeric_limits<std::int32_t>::max() ||
+        offsets[i] > offsets[i + 1])
+      return false;
+    nextId = std::max(nextId, ids[i] + 1);
+  }
+  std::vector<std::uint8_t> present(nextId, 0);
+  for (std::int32_t id : ids) {
+    if (present[id]++)
+      return false;
+  }
+  for (std::int32_t neighborId : neighbors) {
+    if (neighborId < 0 || neighborId >= nextId || !present[neighborId])
+      return false;
+  }
+
+  std::unordered_map<int, NodePtr> nodes;
+  nodes.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto node = std::make_shared<Node>(ids[i], positions[i],
+                                       NODE_CONFIG::BASE_RADIUS);
+    node->setLabel(labels[i]);
+    node->setTarget(flags[i] & 1);
+    node->setNeighbors(std::vector<int>(neighbors.begin() + offsets[i],
+                                        neighbors.begin() + offsets[i + 1]));
+    nodes.emplace(ids[i], std::move(node));
+  }
+  m_nodes = std::move(nodes);
+  return true;
+}
@@ -0,0 +1,270 @@
+#include "GraphReorder.h"
+#include "CompressedAdjacency.h"
+#include "TraversalKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+ReorderReport GraphReorder::apply(Graph &graph, ReorderStrategy strategy) {
+  ReorderReport report{strategy, measure(graph), {}};
+
+  std::vector<int> order;
+  switch (strategy) {
+  case ReorderStrategy::REVERSE_CUTHILL_MCKEE:
+    order = reverseCuthillMcKeeOrder(graph);
+    break;
+  case ReorderStrategy::BFS_ORDER:
+    order = bfsOrder(graph);
+    break;
+  case ReorderStrategy::HILBERT_CURVE:
+    order = hilbertOrder(graph);
+    break;
+  }
+
+  graph.relabel(order);
+
+  report.after = measure(graph);
+  return report;
+}
+
+LocalityMetrics GraphReorder::measure(const Graph &graph) {
+  LocalityMetrics metrics;
+  long long totalGap = 0;
+  long long edgeCount = 0;
+
+  for (const auto &[id, node] : graph.getNodes()) {
+    for (int neighborId : node->getNeighbors()) {
+      if (id < neighborId) {
+        int gap = neighborId - id;
+        metrics.bandwidth = std::max(metrics.bandwidth, gap);
+        totalGap += gap;
+        ++edgeCount;
+      }
+    }
+  }
+
+  if (edgeCount > 0) {
+    metrics.averageGap = static_cast<double>(totalGap) / edgeCount;
+  }
+
+  int source = -1;
+  for (const auto &[id, node] : graph.getNodes()) {
+    if (source == -1 || node->getLabel() < graph.getLabel(source)) {
+      source = id;
+    }
+  }
+  if (source == -1)
+    return metrics;
+
+  const CompressedAdjacency adjacency(graph);
+  metrics.adjacencyBytes = adjacency.getByteSize();
+  std::vector<std::int32_t> level;
+  std::vector<int> queue;
+  for (int run = 0; run < MEASURE_RUNS; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    TraversalKernels::breadthFirstLevels(adjacency, source, level, queue);
+    double micros = std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    if (run == 0 || micros < metrics.bfsMicros) {
+      metrics.bfsMicros = micros;
+    }
+  }
+  return metrics;
+}
+
+const char *GraphReorder::getName(ReorderStrategy strategy) {
+  switch (strategy) {
+  case ReorderStrategy::REVERSE_CUTHILL_MCKEE:
+    return "Reverse Cuthill-McKee";
+  case ReorderStrategy::BFS_ORDER:
+    return "BFS order";
+  case ReorderStrategy::HILBERT_CURVE:
+    return "Hilbert curve";
+  }
+  return "Unknown";
+}
+
+std::vector<int> GraphReorder::reverseCuthillMcKeeOrder(const Graph &graph) {
+  std::vector<int> order;
+  order.reserve(graph.getNodes().size());
+  std::unordered_set<int> visited;
+
+  auto degree = [&graph](int id) {
+    return graph.getNode(id)->getNeighbors().size();
+  };
+
+  // Start each component from a low-degree node near its periphery, then
+  // BFS visiting neighbors in increasing degree order
+  std::vector<int> ids = sortedIds(graph);
+  std::stable_sort(ids.begin(), ids.end(),
+                   [&](int a, int b) { return degree(a) < degree(b); });
+
+  std::vector<int> neighbors;
+  for (int seed : ids) {
+    if (visited.count(seed))
+      continue;
+
+    int start = findPeripheralNode(graph, seed);
+    std::queue<int> queue;
+    queue.push(start);
+    visited.insert(start);
+
+    while (!queue.empty()) {
+      int current = queue.front();
+      queue.pop();
+      order.push_back(current);
+
+      neighbors.clear();
+      for (int neighborId : graph.getNode(current)->getNeighbors()) {
+        if (!visited.count(neighborId)) {
+          neighbors.push_back(neighborId);
+        }
+      }
+      std::sort(neighbors.begin(), neighbors.end(), [&](int a, int b) {
+        return degree(a) != degree(b) ? degree(a) < degree(b) : a < b;
+      });
+      for (int neighborId : neighbors) {
+        visited.insert(neighborId);
+        queue.push(neighborId);
+      }
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+std::vector<int> GraphReorder::bfsOrder(const Graph &graph) {
+  std::vector<int> order;
+  order.reserve(graph.getNodes().size());
+  std::unordered_set<int> visited;
+
+  for (int seed : sortedIds(graph)) {
+    if (visited.count(seed))
+      continue;
+
+    std::queue<int> queue;
+    queue.push(seed);
+    visited.insert(seed);
+    while (!queue.empty()) {
+      int current = queue.front();
+      queue.pop();
+      order.push_back(current);
+
+      for (int neighborId : graph.getNode(current)->getNeighbors()) {
+        if (visited.insert(neighborId).second) {
+          queue.push(neighborId);
+        }
+      }
+    }
+  }
+  return order;
+}
+
+std::vector<int> GraphReorder::hilbertOrder(const Graph &graph) {
+  std::vector<int> ids = sortedIds(graph);
+  if (ids.empty())
+    return ids;
+
+  // Normalise positions onto a 2^16 x 2^16 grid over the bounding box
+  sf::Vector2f lo = graph.getNode(ids.front())->getPosition();
+  sf::Vector2f hi = lo;
+  for (int id : ids) {
+    sf::Vector2f pos = graph.getNode(id)->getPosition();
+    lo.x = std::min(lo.x, pos.x);
+    lo.y = std::min(lo.y, pos.y);
+    hi.x = std::max(hi.x, pos.x);
+    hi.y = std::max(hi.y, pos.y);
+  }
+
+  constexpr std::uint32_t gridSide = 1u << 16;
+  const float spanX = std::max(hi.x - lo.x, 1e-6f);
+  const float spanY = std::max(hi.y - lo.y, 1e-6f);
+
+  // Classic iterative xy -> distance along the Hilbert curve
+  auto hilbertIndex = [](std::uint32_t x, std::uint32_t y) {
+    std::uint64_t d = 0;
+    for (std::uint32_t s = gridSide / 2; s > 0; s /= 2) {
+      std::uint32_t rx = (x & s) ? 1 : 0;
+      std::uint32_t ry = (y & s) ? 1 : 0;
+      d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+      if (ry == 0) {
+        if (rx == 1) {
+          x = gridSide - 1 - x;
+          y = gridSide - 1 - y;
+        }
+        std::swap(x, y);
+      }
+    }
+    return d;
+  };
+
+  std::unordered_map<int, std::uint64_t> key;
+  key.reserve(ids.size());
+  for (int id : ids) {
+    sf::Vector2f pos = graph.getNode(id)->getPosition();
+    auto x = static_cast<std::uint32_t>((pos.x - lo.x) / spanX *
+                                        (gridSide - 1));
+    auto y = static_cast<std::uint32_t>((pos.y - lo.y) / spanY *
+                                        (gridSide - 1));
+    key[id] = hilbertIndex(x, y);
+  }
+
+  std::stable_sort(ids.begin(), ids.end(),
+                   [&key](int a, int b) { return key[a] < key[b]; });
+  return ids;
+}
+
+std::vector<int> GraphReorder::sortedIds(const Graph &graph) {
+  std::vector<int> ids;
+  ids.reserve(graph.getNodes().size());
+  for (const auto &[id, node] : graph.getNodes()) {
+    ids.push_back(id);
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+int GraphReorder::findPeripheralNode(const Graph &graph, int start) {
+  // George-Liu heuristic: repeatedly jump to the farthest, lowest-degree node
+  // of the last BFS level until the eccentricity stops growing
+  int current = start;
+  int eccentricity = -1;
+
+  while (true) {
+    std::unordered_map<int, int> level{{current, 0}};
+    std::queue<int> queue;
+    queue.push(current);
+    int farthest = current;
+
+    while (!queue.empty()) {
+      int id = queue.front();
+      queue.pop();
+      const auto &neighbors = graph.getNode(id)->getNeighbors();
+
+      int farthestDegree =
+          static_cast<int>(graph.getNode(farthest)->getNeighbors().size());
+      if (level[id] > level[farthest] ||
+          (level[id] == level[farthest] &&
+           static_cast<int>(neighbors.size()) < farthestDegree)) {
+        farthest = id;
+      }
+
+      for (int neighborId : neighbors) {
+        if (level.emplace(neighborId, level[id] + 1).second) {
+          queue.push(neighborId);
+        }
+      }
+    }
+
+    if (level[farthest] <= eccentricity)
+      return current;
+    eccentricity = level[farthest];
+    current = farthest;
+  }
+}
@@ -0,0 +1,226 @@
+#include "LodRenderer.h"
+#include "Config.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+
+namespace {
+// Unvisited nodes are white with a black outline at full detail; without
+// the outline they need a fill that shows on the white background
+sf::Color lodColor(const Node &node) {
+  sf::Color color = node.getStateColor();
+  return color == COLOR_CONFIG::UNVISITED ? COLOR_CONFIG::LOD_UNVISITED
+                                          : color;
+}
+
+sf::Color stateColor(NodeState state) {
+  switch (state) {
+  case NodeState::IN_QUEUE:
+    return COLOR_CONFIG::IN_QUEUE;
+  case NodeState::CURRENT:
+    return COLOR_CONFIG::CURRENT;
+  case NodeState::VISITED:
+    return COLOR_CONFIG::VISITED;
+  case NodeState::UNVISITED:
+    break;
+  }
+  return COLOR_CONFIG::LOD_UNVISITED;
+}
+} // namespace
+
+void LodRenderer::draw(sf::RenderWindow &window, sf::Font &font,
+                       const Graph &graph, const SpatialIndex &index,
+                       const sf::View &camera) {
+  const sf::FloatRect area(camera.getCenter() - camera.getSize() / 2.0f,
+                           camera.getSize());
+  const float nodePixels = NODE_CONFIG::BASE_RADIUS * WINDOW_CONFIG::WIDTH /
+                           camera.getSize().x;
+
+  if (nodePixels >= CAMERA_CONFIG::FULL_DETAIL_MIN_RADIUS) {
+    m_tier = LodTier::FULL;
+    index.query(area, m_visibleNodes, m_visibleEdges);
+    graph.draw(window, font, m_visibleEdges, m_visibleNodes);
+    return;
+  }
+
+  // The cell offsets give the node count without collecting anything, so
+  // a view too dense for quads never pays for a full query
+  if (nodePixels >= CAMERA_CONFIG::QUAD_MIN_RADIUS &&
+      index.countNodes(area) <= CAMERA_CONFIG::MAX_QUAD_NODES) {
+    m_tier = LodTier::QUADS;
+    index.query(area, m_visibleNodes, m_visibleEdges);
+    drawQuads(window, graph);
+    return;
+  }
+
+  m_tier = LodTier::HEATMAP;
+  drawHeatmap(window, graph, index, area);
+}
+
+bool LodRenderer::pollRaster() {
+  if (!m_pendingRaster.valid() ||
+      m_pendingRaster.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+    return false;
+  }
+
+  Raster raster = m_pendingRaster.get();
+  if (m_heatmap.getSize() != raster.size) {
+    m_hasHeatmap = m_heatmap.resize(raster.size);
+    m_heatmap.setSmooth(true);
+  }
+  if (!m_hasHeatmap)
+    return false;
+  m_heatmap.update(raster.pixels.data());
+  m_heatmapArea = raster.area;
+  return true;
+}
+
+const char *LodRenderer::getName(LodTier tier) {
+  switch (tier) {
+  case LodTier::FULL:
+    return "full";
+  case LodTier::QUADS:
+    return "quads";
+  case LodTier::HEATMAP:
+    return "heatmap";
+  }
+  return "unknown";
+}
+
+void LodRenderer::drawQuads(sf::RenderWindow &window, const Graph &graph) {
+  m_edgeLines.resize(m_visibleEdges.size() * 2);
+  std::size_t v = 0;
+  for (const auto &[from, to] : m_visibleEdges) {
+    m_edgeLines[v++] = {graph.getNode(from)->getPosition(), COLOR_CONFIG::EDGE,
+                        {}};
+    m_edgeLines[v++] = {graph.getNode(to)->getPosition(), COLOR_CONFIG::EDGE,
+                        {}};
+  }
+  window.draw(m_edgeLines);
+
+  const float r = NODE_CONFIG::BASE_RADIUS;
+  m_nodeQuads.resize(m_visibleNodes.size() * 6);
+  v = 0;
+  for (int id : m_visibleNodes) {
+    const Node &node = *graph.getNode(id);
+    const sf::Vector2f p = node.getPosition();
+    const sf::Color color = lodColor(node);
+    const sf::Vector2f corners[4] = {
+        {p.x - r, p.y - r}, {p.x + r, p.y - r}, {p.x + r, p.y + r},
+        {p.x - r, p.y + r}};
+    for (int corner : {0, 1, 2, 0, 2, 3}) {
+      m_nodeQuads[v++] = {corners[corner], color, {}};
+    }
+  }
+  window.draw(m_nodeQuads);
+}
+
+void LodRenderer::drawHeatmap(sf::RenderWindow &window, const Graph &graph,
+                              const SpatialIndex &index,
+                              const sf::FloatRect &area) {
+  // A finished raster may not have been polled yet this frame
+  pollRaster();
+
+  // A new raster only when the last one is out of date: node states or
+  // positions changed (invalidate()) or the camera moved
+  if (!m_pendingRaster.valid() &&
+      (m_heatmapDirty || !(area == m_requestedArea))) {
+    m_heatmapDirty = false;
+    m_requestedArea = area;
+
+    // Past HEATMAP_MAX_SAMPLES visible nodes only every stride-th one is
+    // taken, straight from the index cells. Density is normalised to the
+    // peak cell and the state mix is a ratio, so a uniform subsample yields
+    // the same picture while the UI-thread work stays bounded.
+    const std::size_t stride =
+        index.countNodes(area) / CAMERA_CONFIG::HEATMAP_MAX_SAMPLES + 1;
+    index.sampleNodes(area, stride, m_visibleNodes);
+    std::vector<HeatmapSample> samples;
+    samples.reserve(m_visibleNodes.size());
+    for (int id : m_visibleNodes) {
+      const Node &node = *graph.getNode(id);
+      samples.push_back({node.getPosition(),
+                         static_cast<std::uint8_t>(node.getState())});
+    }
+    const sf::Vector2u size(
+        WINDOW_CONFIG::WIDTH / CAMERA_CONFIG::HEATMAP_CELL_PIXELS,
+        WINDOW_CONFIG::HEIGHT / CAMERA_CONFIG::HEATMAP_CELL_PIXELS);
+    m_pendingRaster = std::async(std::launch::async, &LodRenderer::rasterize,
+                                 std::move(samples), area, size);
+  }
+
+  if (!m_hasHeatmap)
+    return;
+
+  // One textured quad over the area the raster was taken from
+  const sf::Vector2f lo = m_heatmapArea.position;
+  const sf::Vector2f hi = lo + m_heatmapArea.size;
+  const sf::Vector2f texels(static_cast<float>(m_heatmap.getSize().x),
+                            static_cast<float>(m_heatmap.getSize().y));
+  const sf::Vertex quad[6] = {
+      {lo, sf::Color::White, {0.0f, 0.0f}},
+      {{hi.x, lo.y}, sf::Color::White, {texels.x, 0.0f}},
+      {hi, sf::Color::White, texels},
+      {lo, sf::Color::White, {0.0f, 0.0f}},
+      {hi, sf::Color::White, texels},
+      {{lo.x, hi.y}, sf::Color::White, {0.0f, texels.y}}};
+  window.draw(quad, 6, sf::PrimitiveType::Triangles,
+              sf::RenderStates(&m_heatmap));
+}
+
+LodRenderer::Raster LodRenderer::rasterize(std::vector<HeatmapSample> samples,
+                                           sf::FloatRect area,
+                                           sf::Vector2u size) {
+  Raster raster{area, size, {}};
+  const std::size_t cellCount = static_cast<std::size_t>(size.x) * size.y;
+
+  // Per-cell node count for each of the four states
+  std::vector<std::array<std::uint32_t, 4>> counts(cellCount, {0, 0, 0, 0});
+  const float scaleX = size.x / area.size.x;
+  const float scaleY = size.y / area.size.y;
+  for (const HeatmapSample &sample : samples) {
+    const float fx = (sample.position.x - area.position.x) * scaleX;
+    const float fy = (sample.position.y - area.position.y) * scaleY;
+    if (fx < 0.0f || fy < 0.0f || fx >= size.x || fy >= size.y)
+      continue;
+    const std::size_t cell =
+        static_cast<std::size_t>(fy) * size.x + static_cast<std::size_t>(fx);
+    ++counts[cell][sample.state];
+  }
+
+  std::uint32_t peak = 1;
+  for (const auto &cell : counts) {
+    peak = std::max(peak, cell[0] + cell[1] + cell[2] + cell[3]);
+  }
+
+  // Colour is the state mix of the cell; opacity grows with log density so
+  // sparse regions stay visible next to dense ones
+  const float logPeak = std::log1p(static_cast<float>(peak));
+  raster.pixels.assign(cellCount * 4, 0);
+  for (std::size_t c = 0; c < cellCount; ++c) {
+    const auto &cell = counts[c];
+    const std::uint32_t total = cell[0] + cell[1] + cell[2] + cell[3];
+    if (total == 0)
+      continue;
+
+    float rgb[3] = {0.0f, 0.0f, 0.0f};
+    for (int state = 0; state < 4; ++state) {
+      const sf::Color color = stateColor(static_cast<NodeState>(state));
+      const float weight = static_cast<float>(cell[state]) / total;
+      rgb[0] += color.r * weight;
+      rgb[1] += color.g * weight;
+      rgb[2] += color.b * weight;
+    }
+    const float density = std::log1p(static_cast<float>(total)) / logPeak;
+    std::uint8_t *pixel = &raster.pixels[c * 4];
+    pixel[0] = static_cast<std::uint8_t>(rgb[0]);
+    pixel[1] = static_cast<std::uint8_t>(rgb[1]);
+    pixel[2] = static_cast<std::uint8_t>(rgb[2]);
+    pixel[3] = static_cast<std::uint8_t>(
+        CAMERA_CONFIG::HEATMAP_MIN_ALPHA +
+        (255 - CAMERA_CONFIG::HEATMAP_MIN_ALPHA) * density);
+  }
+  return raster;
+}
@@ -2,9 +2,9 @@
 #include "Config.h"
 
 Node::Node(int id, sf::Vector2f position, float radius)
-    : m_id(id), m_position(position),
+    : m_id(id), m_label(id), m_position(position),
       m_radius(radius > 0 ? radius : NODE_CONFIG::BASE_RADIUS),
-      m_state(NodeState::UNVISITED) {}
+      m_state(NodeState::UNVISITED), m_selected(false), m_target(false) {}
 
 void Node::addNeighbor(int neighborId) {
   // Avoid duplicate neighbors
@@ -15,18 +15,39 @@ void Node::addNeighbor(int neighborId) {
   m_neighbors.push_back(neighborId);
 }
 
+void Node::removeNeighbor(int neighborId) {
+  for (size_t i = 0; i < m_neighbors.size(); ++i) {
+    if (m_neighbors[i] == neighborId) {
+      m_neighbors.erase(m_neighbors.begin() + i);
+      return;
+    }
+  }
+}
+
+bool Node::hasNeighbor(int neighborId) const {
+  for (int id : m_neighbors) {
+    if (id == neighborId)
+      return true;
+  }
+  return false;
+}
+
 void Node::draw(sf::RenderWindow &window, sf::Font &font) const {
   // Draw circle
   sf::CircleShape circle(m_radius);
   circle.setPosition({m_position.x - m_radius, m_position.y - m_radius});
   circle.setFillColor(getStateColor());
-  circle.setOutlineThickness(NODE_CONFIG::OUTLINE_THICKNESS);
-  circle.setOutlineColor(COLOR_CONFIG::EDGE);
+  circle.setOutlineThickness(m_selected || m_target
+                                 ? NODE_CONFIG::SELECTED_OUTLINE_THICKNESS
+                                 : NODE_CONFIG::OUTLINE_THICKNESS);
+  circle.setOutlineColor(m_selected ? COLOR_CONFIG::SELECTED
+                         : m_target ? COLOR_CONFIG::TARGET
+                                    : COLOR_CONFIG::EDGE);
   window.draw(circle);
 
   // Draw node ID
   sf::Text text(font);
-  text.setString(std::to_string(m_id));
+  text.setString(std::to_string(m_label));
   text.setCharacterSize(UI_CONFIG::NODE_FONT_SIZE);
   sf::FloatRect textBounds = text.getLocalBounds();
   text.setPosition({m_position.x - textBounds.size.x / 2.0f,
@@ -44,7 +65,7 @@ bool Node::contains(sf::Vector2f point) const {
 sf::Color Node::getStateColor() const {
   switch (m_state) {
   case NodeState::UNVISITED:
-    return COLOR_CONFIG::UNVISITED;
+    return m_componentColor.value_or(COLOR_CONFIG::UNVISITED);
   case NodeState::IN_QUEUE:
     return COLOR_CONFIG::IN_QUEUE;
   case NodeState::CURRENT:
@@ -0,0 +1,403 @@
+#include "QueryServer.h"
+#include "Config.h"
+#include "Graph.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <span>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+constexpr std::size_t REQUEST_BYTES = 16;
+constexpr std::size_t RESPONSE_HEADER_BYTES = 16;
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void requestStop(int) { stopRequested = 1; }
+
+bool setNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+template <typename T> T readField(const std::uint8_t *data) {
+  T value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+template <typename T> void appendField(std::vector<std::uint8_t> &out, T v) {
+  const auto *bytes = reinterpret_cast<const std::uint8_t *>(&v);
+  out.insert(out.end(), bytes, bytes + sizeof(v));
+}
+
+bool isKnownKind(std::uint8_t kind) {
+  return kind >= static_cast<std::uint8_t>(QueryKind::LEVELS) &&
+         kind <= static_cast<std::uint8_t>(QueryKind::PATH);
+}
+} // namespace
+
+QueryServer::QueryServer(QueryServerOptions options)
+    : m_options(std::move(options)) {}
+
+QueryServer::~QueryServer() {
+  for (const auto &[fd, client] : m_clients) {
+    close(fd);
+  }
+  if (m_listenFd != -1) {
+    close(m_listenFd);
+    unlink(m_options.socketPath.c_str());
+  }
+}
+
+bool QueryServer::loadGraph() {
+  Graph graph;
+  if (!m_options.graphPath.empty()) {
+    if (!graph.loadFromFile(m_options.graphPath))
+      return false;
+  } else {
+    graph.generateSampleGraph(m_options.seed);
+  }
+
+  m_adjacency = CompressedAdjacency(graph);
+  m_present.assign(m_adjacency.getVertexCount(), 0);
+  for (const auto &[id, node] : graph.getNodes()) {
+    m_present[id] = 1;
+  }
+  m_bfs = std::make_unique<BatchedBFS>(m_adjacency);
+
+  std::cout << "Serving " << graph.getNodes().size() << " vertices, "
+            << m_adjacency.getEdgeCount() << " adjacency entries\n";
+  return true;
+}
+
+bool QueryServer::openSocket() {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (m_options.socketPath.size() >= sizeof(address.sun_path)) {
+    std::cerr << "Socket path too long: " << m_options.socketPath << "\n";
+    return false;
+  }
+  std::memcpy(address.sun_path, m_options.socketPath.c_str(),
+              m_options.socketPath.size() + 1);
+
+  m_listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (m_listenFd == -1) {
+    std::cerr << "socket: " << std::strerror(errno) << "\n";
+    return false;
+  }
+
+  // A stale socket file from an earlier run would make bind fail
+  unlink(m_options.socketPath.c_str());
+  if (bind(m_listenFd, reinterpret_cast<const sockaddr *>(&address),
+           sizeof(address)) == -1 ||
+      listen(m_listenFd, SOMAXCONN) == -1 || !setNonBlocking(m_listenFd)) {
+    std::cerr << "Could not listen on " << m_options.socketPath << ": "
+              << std::strerror(errno) << "\n";
+    return false;
+  }
+
+  std::cout << "Listening on " << m_options.socketPath << "\n";
+  return true;
+}
+
+bool QueryServer::run() {
+  if (!loadGraph() || !openSocket())
+    return false;
+
+  std::signal(SIGINT, requestStop);
+  std::signal(SIGTERM, requestStop);
+  std::signal(SIGPIPE, SIG_IGN); // A vanished client is handled by send()
+
+  m_serveStart = m_reportStart = Clock::now();
+  const auto reportInterval =
+      std::chrono::duration<float>(SERVER_CONFIG::REPORT_SECONDS);
+  const auto linger =
+      std::chrono::microseconds(SERVER_CONFIG::BATCH_LINGER_MICROS);
+
+  std::vector<pollfd> pollFds;
+  while (!stopRequested &&
+         (m_options.exitAfterClients == 0 ||
+          m_closedClients < m_options.exitAfterClients)) {
+    // Sleep until input, the oldest query's linger deadline or the report
+    auto deadline =
+        m_reportStart +
+        std::chrono::duration_cast<Clock::duration>(reportInterval);
+    if (!m_pending.empty()) {
+      deadline = std::min(deadline, m_pending.front().received + linger);
+    }
+    auto wait = std::chrono::ceil<std::chrono::milliseconds>(deadline -
+                                                             Clock::now());
+
+    pollFds.clear();
+    pollFds.push_back({m_listenFd, POLLIN, 0});
+    for (const auto &[fd, client] : m_clients) {
+      // A client over its output cap is not read until it drains
+      const std::size_t backlog = getBacklog(client);
+      short events =
+          client.hungUp || backlog >= SERVER_CONFIG::MAX_CLIENT_BACKLOG_BYTES
+              ? 0
+              : POLLIN;
+      if (backlog > 0)
+        events |= POLLOUT;
+      pollFds.push_back({fd, events, 0});
+    }
+    int ready = poll(pollFds.data(), pollFds.size(),
+                     std::max<int>(0, static_cast<int>(wait.count())));
+    if (ready == -1 && errno != EINTR) {
+      std::cerr << "poll: " << std::strerror(errno) << "\n";
+      break;
+    }
+
+    for (const pollfd &entry : pollFds) {
+      if (entry.fd == m_listenFd) {
+        if (entry.revents != 0)
+          acceptClients();
+      } else if (entry.revents & (POLLIN | POLLHUP | POLLERR)) {
+        if (!readClient(entry.fd, m_clients[entry.fd]))
+          closeClient(entry.fd);
+      }
+    }
+
+    const auto now = Clock::now();
+    if (!m_pending.empty() &&
+        (m_pending.size() >= SERVER_CONFIG::MAX_BATCH_QUERIES ||
+         now >= m_pending.front().received + linger)) {
+      answerPending();
+    }
+    flushClients();
+    if (now - m_reportStart >= reportInterval) {
+      report(false);
+    }
+  }
+
+  report(true);
+  return true;
+}
+
+void QueryServer::acceptClients() {
+  while (true) {
+    int fd = accept(m_listenFd, nullptr, nullptr);
+    if (fd == -1)
+      return;
+    if (m_clients.size() >= SERVER_CONFIG::MAX_CLIENTS ||
+        !setNonBlocking(fd)) {
+      close(fd);
+      continue;
+    }
+    m_clients.emplace(fd, Client{});
+  }
+}
+
+bool QueryServer::readClient(int fd, Client &client) {
+  // At most one buffer of requests per poll round, so the answers a round
+  // adds to a client's backlog stay bounded as well
+  std::uint8_t buffer[64 * 1024];
+  std::size_t total = 0;
+  while (total < sizeof(buffer)) {
+    ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+    if (received > 0) {
+      client.in.insert(client.in.end(), buffer, buffer + received);
+      total += received;
+      continue;
+    }
+    if (received == 0) {
+      // Half-closed: answer what was sent, then close (see flushClients)
+      client.hungUp = true;
+      break;
+    }
+    if (errno == EINTR)
+      continue;
+    if (errno != EAGAIN && errno != EWOULDBLOCK)
+      return false;
+    break;
+  }
+
+  parseRequests(fd, client);
+  return true;
+}
+
+bool QueryServer::writeClient(int fd, Client &client) {
+  if (client.sent == client.out.size())
+    return true;
+  while (client.sent < client.out.size()) {
+    ssize_t written = send(fd, client.out.data() + client.sent,
+                           client.out.size() - client.sent, 0);
+    if (written > 0) {
+      client.sent += written;
+      continue;
+    }
+    if (written == -1 && errno == EINTR)
+      continue;
+    return written == -1 && (errno == EAGAIN || errno == EWOULDBLOCK);
+  }
+  client.out.clear();
+  client.sent = 0;
+  return true;
+}
+
+void QueryServer::parseRequests(int fd, Client &client) {
+  const auto now = Clock::now();
+  std::size_t offset = 0;
+  for (; offset + REQUEST_BYTES <= client.in.size();
+       offset += REQUEST_BYTES) {
+    const std::uint8_t *request = client.in.data() + offset;
+    std::uint32_t id = readField<std::uint32_t>(request);
+    std::uint8_t kind = request[4];
+    BfsQuery query;
+    query.source = readField<std::int32_t>(request + 8);
+    query.target = readField<std::int32_t>(request + 12);
+
+    if (!isKnownKind(kind)) {
+      respond(fd, id, static_cast<QueryKind>(kind), Status::BAD_KIND, -1, {});
+      continue;
+    }
+    query.kind = static_cast<QueryKind>(kind);
+
+    auto valid = [this](int vertex) {
+      return vertex >= 0 && vertex < m_adjacency.getVertexCount() &&
+             m_present[vertex];
+    };
+    if (!valid(query.source) ||
+        (query.kind != QueryKind::LEVELS && !valid(query.target))) {
+      respond(fd, id, query.kind, Status::BAD_VERTEX, -1, {});
+      continue;
+    }
+
+    m_queries.push_back(std::move(query));
+    m_pending.push_back({fd, id, now});
+    ++client.waiting;
+  }
+  client.in.erase(client.in.begin(), client.in.begin() + offset);
+}
+
+void QueryServer::answerPending() {
+  std::span<BfsQuery> queries(m_queries);
+  for (std::size_t done = 0; done < queries.size();) {
+    done += m_bfs->run(queries.subspan(done));
+    m_lanes += m_bfs->getLaneCount();
+    ++m_batches;
+  }
+
+  std::vector<std::uint32_t> payload;
+  for (std::size_t i = 0; i < m_queries.size(); ++i) {
+    const BfsQuery &query = m_queries[i];
+    int value = query.distance;
+    payload.clear();
+    if (query.kind == QueryKind::REACHABLE) {
+      value = query.distance >= 0 ? 1 : 0;
+    } else if (query.kind == QueryKind::LEVELS) {
+      payload = query.levels;
+    } else if (query.kind == QueryKind::PATH) {
+      payload.assign(query.path.begin(), query.path.end());
+    }
+
+    respond(m_pending[i].fd, m_pending[i].id, query.kind, Status::OK, value,
+            payload);
+    --m_clients[m_pending[i].fd].waiting;
+  }
+
+  const auto now = Clock::now();
+  for (const Pending &pending : m_pending) {
+    m_latencies.push_back(
+        std::chrono::duration<double, std::micro>(now - pending.received)
+            .count());
+  }
+  m_queries.clear();
+  m_pending.clear();
+}
+
+void QueryServer::flushClients() {
+  // Whatever doesn't fit in the socket buffer waits for POLLOUT
+  std::vector<int> closed;
+  for (auto &[fd, client] : m_clients) {
+    m_peakBacklog = std::max(m_peakBacklog, getBacklog(client));
+    bool open = writeClient(fd, client);
+    bool finished = client.hungUp && client.waiting == 0 &&
+                    client.sent == client.out.size();
+    if (!open || finished)
+      closed.push_back(fd);
+  }
+  for (int fd : closed) {
+    closeClient(fd);
+  }
+}
+
+void QueryServer::closeClient(int fd) {
+  close(fd);
+  m_clients.erase(fd);
+  ++m_closedClients;
+
+  // The fd number can be reused by the next accept, so queries still
+  // waiting on it must not be answered to whoever gets it
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < m_pending.size(); ++i) {
+    if (m_pending[i].fd != fd) {
+      m_pending[kept] = m_pending[i];
+      m_queries[kept] = std::move(m_queries[i]);
+      ++kept;
+    }
+  }
+  m_pending.resize(kept);
+  m_queries.resize(kept);
+}
+
+void QueryServer::respond(int fd, std::uint32_t id, QueryKind kind,
+                          Status status, int value,
+                          const std::vector<std::uint32_t> &payload) {
+  // No exact reserve here: it would defeat geometric growth and copy the
+  // whole backlog on every answer
+  std::vector<std::uint8_t> &out = m_clients[fd].out;
+  appendField(out, id);
+  appendField(out, static_cast<std::uint8_t>(kind));
+  appendField(out, static_cast<std::uint8_t>(status));
+  appendField(out, std::uint16_t{0});
+  appendField(out, static_cast<std::int32_t>(value));
+  appendField(out, static_cast<std::uint32_t>(payload.size()));
+  for (std::uint32_t word : payload) {
+    appendField(out, word);
+  }
+}
+
+void QueryServer::report(bool final) {
+  const auto now = Clock::now();
+  const double seconds =
+      std::chrono::duration<double>(now - m_reportStart).count();
+  m_reportStart = now;
+  m_totalQueries += m_latencies.size();
+  m_totalBatches += m_batches;
+
+  if (!m_latencies.empty()) {
+    std::sort(m_latencies.begin(), m_latencies.end());
+    auto percentile = [this](double p) {
+      return m_latencies[static_cast<std::size_t>(
+          p * (m_latencies.size() - 1))];
+    };
+    std::cout << m_latencies.size() << " queries in " << m_batches
+              << " batches (" << static_cast<double>(m_lanes) / m_batches
+              << " lanes, "
+              << static_cast<double>(m_latencies.size()) / m_batches
+              << " queries per batch), " << m_latencies.size() / seconds
+              << " q/s; latency p50 " << percentile(0.5) << " us, p99 "
+              << percentile(0.99) << " us, max " << m_latencies.back()
+              << " us\n";
+  }
+  m_latencies.clear();
+  m_batches = 0;
+  m_lanes = 0;
+
+  if (final) {
+    const double total =
+        std::chrono::duration<double>(now - m_serveStart).count();
+    std::cout << "Served " << m_totalQueries << " queries in "
+              << m_totalBatches << " batches over " << total
+              << " s; largest client backlog " << m_peakBacklog / 1024
+              << " KiB\n";
+  }
+}
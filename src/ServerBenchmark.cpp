@@ -0,0 +1,561 @@
+#include "ServerBenchmark.h"
+#include "BatchedBFS.h"
+#include "CompressedAdjacency.h"
+#include "Config.h"
+#include "Graph.h"
+#include "Philox.h"
+#include "QueryServer.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <poll.h>
+#include <span>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t RESPONSE_HEADER_BYTES = 16;
+// Serving queries share this many sources, so a batch never splits on
+// PATH lanes and every reply can be checked against one BFS per source
+constexpr int SOURCE_POOL = SERVER_CONFIG::MAX_PATH_LANES;
+constexpr int REPEATS = 3;      // Batching timings are best of
+
+void buildRandomGraph(Graph &graph, int vertices, int degree,
+                      std::uint64_t seed) {
+  Philox4x32 rng(seed);
+  for (int id = 0; id < vertices; ++id) {
+    graph.addNode(id, {0.0f, 0.0f});
+  }
+  const long long edges = static_cast<long long>(vertices) * degree / 2;
+  for (long long e = 0; e < edges; ++e) {
+    int u = rng.uniformInt(0, vertices - 1);
+    int v = rng.uniformInt(0, vertices - 1);
+    if (u != v && !graph.hasEdge(u, v))
+      graph.addEdge(u, v);
+  }
+}
+
+// Hop distances from `source`, -1 where unreachable
+void referenceDistances(const CompressedAdjacency &adjacency, int source,
+                        std::vector<int> &distance, std::vector<int> &queue) {
+  distance.assign(adjacency.getVertexCount(), -1);
+  queue.clear();
+  distance[source] = 0;
+  queue.push_back(source);
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    int current = queue[head];
+    for (int neighborId : adjacency.neighbors(current)) {
+      if (distance[neighborId] == -1) {
+        distance[neighborId] = distance[current] + 1;
+        queue.push_back(neighborId);
+      }
+    }
+  }
+}
+
+std::vector<std::uint32_t> levelCounts(const std::vector<int> &distance) {
+  std::vector<std::uint32_t> levels;
+  for (int d : distance) {
+    if (d < 0)
+      continue;
+    if (d >= static_cast<int>(levels.size()))
+      levels.resize(d + 1, 0);
+    ++levels[d];
+  }
+  return levels;
+}
+
+// One plain BFS per PATH query: parents until the target is reached
+std::vector<int> referencePath(const CompressedAdjacency &adjacency,
+                               int source, int target,
+                               std::vector<int> &parent,
+                               std::vector<int> &queue) {
+  parent.assign(adjacency.getVertexCount(), -1);
+  queue.clear();
+  parent[source] = source;
+  queue.push_back(source);
+  for (std::size_t head = 0; head < queue.size() && parent[target] == -1;
+       ++head) {
+    int current = queue[head];
+    for (int neighborId : adjacency.neighbors(current)) {
+      if (parent[neighborId] == -1) {
+        parent[neighborId] = current;
+        queue.push_back(neighborId);
+      }
+    }
+  }
+  std::vector<int> path;
+  if (parent[target] == -1)
+    return path;
+  for (int v = target; v != source; v = parent[v]) {
+    path.push_back(v);
+  }
+  path.push_back(source);
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+// A reported path must run source..target over real edges in `hops` steps
+template <typename Path>
+bool isValidPath(const CompressedAdjacency &adjacency, const Path &path,
+                 int source, int target, int hops) {
+  if (static_cast<int>(path.size()) != hops + 1 ||
+      static_cast<int>(path.front()) != source ||
+      static_cast<int>(path.back()) != target)
+    return false;
+  for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+    bool adjacent = false;
+    for (int neighborId : adjacency.neighbors(static_cast<int>(path[i]))) {
+      adjacent = adjacent || neighborId == static_cast<int>(path[i + 1]);
+    }
+    if (!adjacent)
+      return false;
+  }
+  return true;
+}
+
+double millisSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+template <typename T> void appendField(std::vector<std::uint8_t> &out, T v) {
+  const auto *bytes = reinterpret_cast<const std::uint8_t *>(&v);
+  out.insert(out.end(), bytes, bytes + sizeof(v));
+}
+
+template <typename T> T readField(const std::uint8_t *data) {
+  T value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+// What one client asked, by request id, and the answers to check against
+struct Expected {
+  std::uint8_t kind;
+  std::uint8_t status; // 0 OK, 1 BAD_VERTEX, 2 BAD_KIND
+  int poolIndex;       // Source, as an index into the distance pool
+  int target;
+};
+
+struct ServingClient {
+  int fd = -1;
+  bool slow = false;
+  std::vector<std::uint8_t> requests;
+  std::vector<Expected> expected;
+  std::string error; // Empty: every answer arrived and was correct
+  Clock::time_point finished;
+};
+
+class ReplyChecker {
+public:
+  ReplyChecker(const CompressedAdjacency &adjacency,
+               const std::vector<int> &sources,
+               const std::vector<std::vector<int>> &distances)
+      : m_adjacency(adjacency), m_sources(sources), m_distances(distances) {
+    for (const std::vector<int> &distance : distances) {
+      m_levels.push_back(levelCounts(distance));
+    }
+  }
+
+  // Empty if the reply matches
+  std::string check(const Expected &expected, const std::uint8_t *reply,
+                    std::uint32_t count) const {
+    const std::uint8_t status = reply[5];
+    const int value = readField<std::int32_t>(reply + 8);
+    if (status != expected.status)
+      return "status " + std::to_string(status);
+    if (status != 0)
+      return {};
+
+    const std::vector<int> &distance = m_distances[expected.poolIndex];
+    const int hops = distance[expected.target];
+    std::vector<std::uint32_t> payload(count);
+    std::memcpy(payload.data(), reply + RESPONSE_HEADER_BYTES, 4 * count);
+    switch (static_cast<QueryKind>(expected.kind)) {
+    case QueryKind::LEVELS: {
+      const std::vector<std::uint32_t> &levels =
+          m_levels[expected.poolIndex];
+      if (payload != levels ||
+          value != static_cast<int>(levels.size()) - 1)
+        return "wrong LEVELS";
+      return {};
+    }
+    case QueryKind::REACHABLE:
+      return value == (hops >= 0 ? 1 : 0) ? "" : "wrong REACHABLE";
+    case QueryKind::DISTANCE:
+      return value == hops ? "" : "wrong DISTANCE";
+    case QueryKind::PATH:
+      if (value != hops)
+        return "wrong PATH length";
+      if (hops >= 0 &&
+          !isValidPath(m_adjacency, payload,
+                       m_sources[expected.poolIndex], expected.target, hops))
+        return "invalid PATH";
+      return {};
+    }
+    return "unknown kind";
+  }
+
+private:
+  const CompressedAdjacency &m_adjacency;
+  const std::vector<int> &m_sources;
+  const std::vector<std::vector<int>> &m_distances;
+  std::vector<std::vector<std::uint32_t>> m_levels;
+};
+
+// Pipelines every request while reading replies, so neither side stalls.
+// A slow client reads nothing until the server has stopped taking its
+// requests for a while, and from then on small chunks with a pause in
+// between. Without the output cap it would send everything before reading.
+void driveClient(ServingClient &client, const ReplyChecker &checker) {
+  constexpr std::size_t SLOW_READ_BYTES = 4096;
+  constexpr int SLOW_STALL_MILLIS = 1000;
+  bool reading = !client.slow;
+  std::vector<std::uint8_t> in;
+  std::vector<std::uint8_t> buffer(64 * 1024);
+  std::size_t sent = 0;
+  std::size_t parsed = 0;
+  std::size_t answered = 0;
+  std::vector<std::uint8_t> seen(client.expected.size(), 0);
+
+  while (true) {
+    const bool sending = sent < client.requests.size();
+    const bool holdingBack = !reading && sending;
+    pollfd entry{client.fd, POLLIN, 0};
+    if (sending)
+      entry.events |= POLLOUT;
+    if (holdingBack)
+      entry.events = POLLOUT;
+    int ready = poll(&entry, 1, holdingBack ? SLOW_STALL_MILLIS : 60000);
+    if (ready < 0 || (ready == 0 && !holdingBack)) {
+      client.error = "timed out";
+      return;
+    }
+    if (ready == 0) {
+      reading = true;
+      continue;
+    }
+
+    if (entry.revents & POLLOUT) {
+      ssize_t written = send(client.fd, client.requests.data() + sent,
+                             client.requests.size() - sent, MSG_NOSIGNAL);
+      if (written > 0)
+        sent += written;
+      if (sent == client.requests.size())
+        shutdown(client.fd, SHUT_WR); // Server closes once all are answered
+      else if (holdingBack)
+        continue;
+    }
+    if (!(entry.revents & (POLLIN | POLLHUP | POLLERR)))
+      continue;
+
+    ssize_t received =
+        recv(client.fd, buffer.data(),
+             client.slow ? SLOW_READ_BYTES : buffer.size(), 0);
+    if (received == 0)
+      break;
+    if (received < 0) {
+      if (errno == EAGAIN || errno == EINTR)
+        continue;
+      client.error = std::strerror(errno);
+      return;
+    }
+    in.insert(in.end(), buffer.begin(), buffer.begin() + received);
+
+    while (in.size() - parsed >= RESPONSE_HEADER_BYTES) {
+      const std::uint8_t *reply = in.data() + parsed;
+      const std::uint32_t count = readField<std::uint32_t>(reply + 12);
+      if (in.size() - parsed < RESPONSE_HEADER_BYTES + 4 * count)
+        break;
+      const std::uint32_t id = readField<std::uint32_t>(reply);
+      if (id >= seen.size() || seen[id]++) {
+        client.error = "unexpected reply id " + std::to_string(id);
+        return;
+      }
+      std::string error = checker.check(client.expected[id], reply, count);
+      if (!error.empty()) {
+        client.error = error + " for request " + std::to_string(id);
+        return;
+      }
+      parsed += RESPONSE_HEADER_BYTES + 4 * count;
+      ++answered;
+    }
+    in.erase(in.begin(), in.begin() + parsed);
+    parsed = 0;
+
+    if (client.slow)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  client.finished = Clock::now();
+  if (answered != client.expected.size()) {
+    client.error = std::to_string(answered) + " of " +
+                   std::to_string(client.expected.size()) + " answered";
+  }
+}
+
+int connectTo(const std::string &path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  // The server loads the graph before it listens
+  const auto deadline = Clock::now() + std::chrono::seconds(30);
+  while (Clock::now() < deadline) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1)
+      return -1;
+    if (connect(fd, reinterpret_cast<const sockaddr *>(&address),
+                sizeof(address)) == 0) {
+      int flags = fcntl(fd, F_GETFL, 0);
+      fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+      return fd;
+    }
+    close(fd);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return -1;
+}
+} // namespace
+
+ServerBenchmark::ServerBenchmark(ServerBenchmarkOptions options)
+    : m_options(options) {}
+
+bool ServerBenchmark::run() {
+  std::cout << "Building " << m_options.vertices
+            << "-vertex random graph, average degree " << m_options.degree
+            << "..." << std::endl;
+  Graph graph;
+  buildRandomGraph(graph, m_options.vertices, m_options.degree,
+                   m_options.seed);
+  CompressedAdjacency adjacency(graph);
+
+  const std::string graphPath =
+      (std::filesystem::temp_directory_path() /
+       ("bfs-bench-" + std::to_string(getpid()) + ".txt"))
+          .string();
+  {
+    std::ofstream out(graphPath);
+    graph.save(out);
+    if (!out) {
+      std::cerr << "Could not write " << graphPath << std::endl;
+      return false;
+    }
+  }
+
+  bool ok = runBatching(adjacency) && runServing(adjacency, graphPath);
+  std::filesystem::remove(graphPath);
+  return ok;
+}
+
+bool ServerBenchmark::runBatching(const CompressedAdjacency &adjacency) {
+  Philox4x32 rng(m_options.seed, 1);
+  const int vertices = adjacency.getVertexCount();
+  std::vector<int> distance, parent, queue;
+
+  for (QueryKind kind : {QueryKind::LEVELS, QueryKind::PATH}) {
+    std::vector<BfsQuery> queries(m_options.batchQueries);
+    for (BfsQuery &query : queries) {
+      query.kind = kind;
+      query.source = rng.uniformInt(0, vertices - 1);
+      query.target = rng.uniformInt(0, vertices - 1);
+    }
+
+    // Batched: BatchedBFS takes as many queries per sweep as fit
+    BatchedBFS bfs(adjacency);
+    std::vector<BfsQuery> answered;
+    double batchedMillis = 0.0;
+    std::size_t batches = 0;
+    for (int repeat = 0; repeat < REPEATS; ++repeat) {
+      answered = queries;
+      std::span<BfsQuery> pending(answered);
+      batches = 0;
+      auto start = Clock::now();
+      for (std::size_t done = 0; done < pending.size(); ++batches) {
+        done += bfs.run(pending.subspan(done));
+      }
+      double millis = millisSince(start);
+      if (repeat == 0 || millis < batchedMillis)
+        batchedMillis = millis;
+    }
+
+    // One plain BFS per query, checked against the batched answers
+    double singleMillis = 0.0;
+    for (int repeat = 0; repeat < REPEATS; ++repeat) {
+      auto start = Clock::now();
+      for (const BfsQuery &query : queries) {
+        if (kind == QueryKind::LEVELS) {
+          referenceDistances(adjacency, query.source, distance, queue);
+        } else {
+          referencePath(adjacency, query.source, query.target, parent,
+                        queue);
+        }
+      }
+      double millis = millisSince(start);
+      if (repeat == 0 || millis < singleMillis)
+        singleMillis = millis;
+    }
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      const BfsQuery &query = answered[i];
+      bool correct;
+      if (kind == QueryKind::LEVELS) {
+        referenceDistances(adjacency, query.source, distance, queue);
+        correct = query.levels == levelCounts(distance);
+      } else {
+        std::vector<int> path = referencePath(adjacency, query.source,
+                                              query.target, parent, queue);
+        int hops = static_cast<int>(path.size()) - 1;
+        correct = query.distance == hops &&
+                  (hops < 0 || isValidPath(adjacency, query.path,
+                                           query.source, query.target, hops));
+      }
+      if (!correct) {
+        std::cerr << "Batched answer " << i << " differs from plain BFS"
+                  << std::endl;
+        return false;
+      }
+    }
+
+    std::cout << "  " << (kind == QueryKind::LEVELS ? "LEVELS" : "PATH")
+              << ": " << queries.size() << " queries, batched "
+              << batchedMillis << " ms in " << batches
+              << " sweeps vs. one BFS each " << singleMillis << " ms ("
+              << singleMillis / batchedMillis << "x)" << std::endl;
+  }
+  return true;
+}
+
+bool ServerBenchmark::runServing(const CompressedAdjacency &adjacency,
+                                 const std::string &graphPath) {
+  Philox4x32 rng(m_options.seed, 2);
+  const int vertices = adjacency.getVertexCount();
+
+  std::vector<int> sources(SOURCE_POOL);
+  std::vector<std::vector<int>> distances(SOURCE_POOL);
+  std::vector<int> queue;
+  for (int k = 0; k < SOURCE_POOL; ++k) {
+    sources[k] = rng.uniformInt(0, vertices - 1);
+    referenceDistances(adjacency, sources[k], distances[k], queue);
+  }
+  ReplyChecker checker(adjacency, sources, distances);
+
+  // Mixed kinds with about 1% invalid requests. The last client asks
+  // LEVELS only, four times as often, and reads slowly: its answers
+  // outgrow the output cap unless the server stops reading from it.
+  std::vector<ServingClient> clients(m_options.clients);
+  for (int c = 0; c < m_options.clients; ++c) {
+    ServingClient &client = clients[c];
+    client.slow = c + 1 == m_options.clients;
+    const int count = m_options.queriesPerClient * (client.slow ? 4 : 1);
+    for (int id = 0; id < count; ++id) {
+      Expected expected{};
+      expected.kind = client.slow
+                          ? static_cast<std::uint8_t>(QueryKind::LEVELS)
+                          : static_cast<std::uint8_t>(rng.uniformInt(1, 4));
+      expected.poolIndex = rng.uniformInt(0, SOURCE_POOL - 1);
+      expected.target = rng.uniformInt(0, vertices - 1);
+      int source = sources[expected.poolIndex];
+      const int roll = rng.uniformInt(0, 199);
+      if (roll == 0) {
+        expected.kind = 9;
+        expected.status = 2;
+      } else if (roll == 1) {
+        source = vertices + 7;
+        expected.status = 1;
+      }
+      appendField(client.requests, static_cast<std::uint32_t>(id));
+      appendField(client.requests, expected.kind);
+      appendField(client.requests, std::uint8_t{0});
+      appendField(client.requests, std::uint16_t{0});
+      appendField(client.requests, static_cast<std::int32_t>(source));
+      appendField(client.requests,
+                  static_cast<std::int32_t>(expected.target));
+      client.expected.push_back(expected);
+    }
+  }
+
+  QueryServerOptions serverOptions;
+  serverOptions.socketPath =
+      (std::filesystem::temp_directory_path() /
+       ("bfs-bench-" + std::to_string(getpid()) + ".sock"))
+          .string();
+  serverOptions.graphPath = graphPath;
+  serverOptions.exitAfterClients = clients.size();
+  QueryServer server(serverOptions);
+  bool served = false;
+  std::thread serverThread([&]() { served = server.run(); });
+
+  // Everyone connects before anyone sends, so the server sees every client
+  // before the first one finishes
+  for (ServingClient &client : clients) {
+    client.fd = connectTo(serverOptions.socketPath);
+    if (client.fd == -1) {
+      std::cerr << "Could not connect to " << serverOptions.socketPath
+                << std::endl;
+      for (ServingClient &opened : clients) {
+        if (opened.fd != -1)
+          close(opened.fd);
+      }
+      serverThread.join();
+      return false;
+    }
+  }
+
+  auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (ServingClient &client : clients) {
+    threads.emplace_back(driveClient, std::ref(client), std::cref(checker));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  // Throughput of the clients that keep up; the slow one finishes last
+  std::size_t total = 0;
+  auto finished = start;
+  for (ServingClient &client : clients) {
+    close(client.fd);
+    if (!client.slow) {
+      total += client.expected.size();
+      finished = std::max(finished, client.finished);
+    }
+  }
+  const double seconds = std::chrono::duration<double>(finished - start)
+                             .count();
+  serverThread.join();
+
+  for (std::size_t c = 0; c < clients.size(); ++c) {
+    if (!clients[c].error.empty()) {
+      std::cerr << "Client " << c << ": " << clients[c].error << std::endl;
+      return false;
+    }
+  }
+  // The slow client's answers alone are several times the cap; what the
+  // server held for it may pass the cap only by the answers to one read
+  const std::size_t cap = SERVER_CONFIG::MAX_CLIENT_BACKLOG_BYTES;
+  if (!served || server.getPeakBacklog() > cap + cap / 2) {
+    std::cerr << "Server backlog reached " << server.getPeakBacklog() / 1024
+              << " KiB (cap " << cap / 1024 << " KiB)" << std::endl;
+    return false;
+  }
+
+  std::cout << "  serving: " << clients.size() - 1 << " clients, " << total
+            << " pipelined mixed queries in " << seconds << " s ("
+            << static_cast<double>(total) / seconds << " q/s)\n"
+            << "  slow reader: " << clients.back().expected.size()
+            << " LEVELS queries, largest backlog "
+            << server.getPeakBacklog() / 1024 << " KiB (cap " << cap / 1024
+            << " KiB)\n"
+            << "  every answer correct" << std::endl;
+  return true;
+}
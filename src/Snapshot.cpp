@@ -0,0 +1,163 @@
+#include "Snapshot.h"
+#include <array>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+constexpr std::array<char, 8> MAGIC = {'B', 'F', 'S', 'S', 'N', 'A', 'P', 0};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint64_t ALIGNMENT = 64;
+
+struct FileHeader {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t sectionCount;
+  std::uint64_t fileSize;
+  std::uint8_t reserved[40];
+};
+static_assert(sizeof(FileHeader) == 64);
+
+std::uint64_t alignUp(std::uint64_t offset) {
+  return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+} // namespace
+
+bool SnapshotWriter::writeFile(const std::string &path) const {
+  // Lay out the table first so every offset is known before writing
+  std::vector<SnapshotTableEntry> table;
+  std::uint64_t offset =
+      alignUp(sizeof(FileHeader) +
+              m_entries.size() * sizeof(SnapshotTableEntry));
+  for (const Entry &entry : m_entries) {
+    table.push_back({static_cast<std::uint32_t>(entry.section),
+                     entry.elementSize, offset, entry.count});
+    offset = alignUp(offset + entry.elementSize * entry.count);
+  }
+
+  FileHeader header{};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.sectionCount = static_cast<std::uint32_t>(m_entries.size());
+  header.fileSize = offset;
+
+  const std::string temporary = path + ".tmp";
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      std::cerr << "Could not write snapshot: " << temporary << "\n";
+      return false;
+    }
+
+    static const char padding[ALIGNMENT] = {};
+    auto padTo = [&out](std::uint64_t position) {
+      auto current = static_cast<std::uint64_t>(out.tellp());
+      out.write(padding, static_cast<std::streamsize>(position - current));
+    };
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(table.data()),
+              static_cast<std::streamsize>(table.size() *
+                                           sizeof(SnapshotTableEntry)));
+    for (std::size_t i = 0; i < m_entries.size(); ++i) {
+      padTo(table[i].offset);
+      const Entry &entry = m_entries[i];
+      out.write(static_cast<const char *>(entry.data),
+                static_cast<std::streamsize>(entry.elementSize * entry.count));
+    }
+    padTo(header.fileSize);
+    if (!out.flush()) {
+      std::cerr << "Could not write snapshot: " << temporary << "\n";
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    std::cerr << "Could not replace " << path << ": " << error.message()
+              << "\n";
+    return false;
+  }
+  return true;
+}
+
+SnapshotReader::~SnapshotReader() { close(); }
+
+void SnapshotReader::close() {
+  if (m_data) {
+    munmap(const_cast<std::uint8_t *>(m_data), m_size);
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_table = {};
+}
+
+bool SnapshotReader::open(const std::string &path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    std::cerr << "Could not open snapshot: " << path << "\n";
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) == -1 ||
+      static_cast<std::size_t>(info.st_size) < sizeof(FileHeader)) {
+    std::cerr << path << ": not a snapshot\n";
+    ::close(fd);
+    return false;
+  }
+
+  // The mapping stays valid after the descriptor is closed
+  m_size = static_cast<std::size_t>(info.st_size);
+  void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    std::cerr << "Could not map snapshot: " << path << "\n";
+    m_size = 0;
+    return false;
+  }
+  m_data = static_cast<const std::uint8_t *>(data);
+
+  FileHeader header;
+  std::memcpy(&header, m_data, sizeof(header));
+  const std::uint64_t tableEnd =
+      sizeof(FileHeader) +
+      std::uint64_t{header.sectionCount} * sizeof(SnapshotTableEntry);
+  if (header.magic != MAGIC || header.version != VERSION ||
+      header.fileSize != m_size || tableEnd > m_size) {
+    std::cerr << path << ": not a snapshot of this version\n";
+    close();
+    return false;
+  }
+
+  // Every section must lie inside the file, aligned for its element type
+  m_table = {reinterpret_cast<const SnapshotTableEntry *>(m_data +
+                                                          sizeof(FileHeader)),
+             header.sectionCount};
+  for (const SnapshotTableEntry &entry : m_table) {
+    bool valid = entry.elementSize != 0 && entry.offset % ALIGNMENT == 0 &&
+                 entry.offset >= tableEnd && entry.offset <= m_size &&
+                 entry.count <= (m_size - entry.offset) / entry.elementSize;
+    if (!valid) {
+      std::cerr << path << ": corrupt section table\n";
+      close();
+      return false;
+    }
+  }
+  return true;
+}
+
+const SnapshotTableEntry *
+SnapshotReader::find(SnapshotSection section) const {
+  for (const SnapshotTableEntry &entry : m_table) {
+    if (entry.section == static_cast<std::uint32_t>(section))
+      return &entry;
+  }
+  return nullptr;
+}
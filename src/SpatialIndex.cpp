@@ -0,0 +1,251 @@
+#include "SpatialIndex.h"
+#include "Config.h"
+#include "Graph.h"
+#include <algorithm>
+#include <cmath>
+
+void SpatialIndex::build(const Graph &graph) {
+  m_edges.clear();
+  m_edgeBounds.clear();
+  m_longEdges.clear();
+  m_nodeItems.clear();
+  m_edgeItems.clear();
+  m_drift = 0.0f;
+
+  const auto &nodes = graph.getNodes();
+  if (nodes.empty()) {
+    m_columns = m_rows = 0;
+    m_nodeCellStart.assign(1, 0);
+    m_edgeCellStart.assign(1, 0);
+    return;
+  }
+
+  // Grid bounds from node centres; the cell size grows with the area so the
+  // grid stays around one cell per node on very large or sparse graphs
+  sf::Vector2f lo = nodes.begin()->second->getPosition();
+  sf::Vector2f hi = lo;
+  for (const auto &[id, node] : nodes) {
+    sf::Vector2f p = node->getPosition();
+    lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+    hi = {std::max(hi.x, p.x), std::max(hi.y, p.y)};
+  }
+  const sf::Vector2f extent = hi - lo;
+  m_cellSize = std::max(
+      GRAPH_CONFIG::SPATIAL_CELL_SIZE,
+      std::sqrt(extent.x * extent.y / static_cast<float>(nodes.size())));
+  m_origin = lo;
+  m_columns = static_cast<int>(extent.x / m_cellSize) + 1;
+  m_rows = static_cast<int>(extent.y / m_cellSize) + 1;
+  const std::size_t cellCount =
+      static_cast<std::size_t>(m_columns) * static_cast<std::size_t>(m_rows);
+
+  auto cellOf = [this](sf::Vector2f p) {
+    int column = std::clamp(static_cast<int>((p.x - m_origin.x) / m_cellSize),
+                            0, m_columns - 1);
+    int row = std::clamp(static_cast<int>((p.y - m_origin.y) / m_cellSize), 0,
+                         m_rows - 1);
+    return static_cast<std::size_t>(row) * m_columns + column;
+  };
+
+  // Nodes: count per cell, prefix-sum, scatter
+  m_nodeCellStart.assign(cellCount + 1, 0);
+  for (const auto &[id, node] : nodes) {
+    ++m_nodeCellStart[cellOf(node->getPosition()) + 1];
+  }
+  for (std::size_t c = 0; c < cellCount; ++c) {
+    m_nodeCellStart[c + 1] += m_nodeCellStart[c];
+  }
+  m_nodeItems.resize(nodes.size());
+  std::vector<std::uint32_t> cursor(m_nodeCellStart.begin(),
+                                    m_nodeCellStart.end() - 1);
+  for (const auto &[id, node] : nodes) {
+    m_nodeItems[cursor[cellOf(node->getPosition())]++] = id;
+  }
+
+  // Edges: one entry per covered cell, or the long-edge list
+  for (const auto &[id, node] : nodes) {
+    for (int neighborId : node->getNeighbors()) {
+      auto neighbor = graph.getNode(neighborId);
+      if (!neighbor || neighborId < id)
+        continue;
+      sf::Vector2f a = node->getPosition();
+      sf::Vector2f b = neighbor->getPosition();
+      sf::Vector2f min(std::min(a.x, b.x), std::min(a.y, b.y));
+      sf::Vector2f max(std::max(a.x, b.x), std::max(a.y, b.y));
+      m_edges.emplace_back(id, neighborId);
+      m_edgeBounds.emplace_back(min, max - min);
+    }
+  }
+
+  m_edgeCellStart.assign(cellCount + 1, 0);
+  std::vector<CellRange> ranges(m_edges.size());
+  for (std::uint32_t e = 0; e < m_edges.size(); ++e) {
+    ranges[e] = cellsCovering(m_edgeBounds[e]);
+    const CellRange &r = ranges[e];
+    const int covered = (r.column1 - r.column0 + 1) * (r.row1 - r.row0 + 1);
+    if (covered > GRAPH_CONFIG::MAX_EDGE_CELLS) {
+      m_longEdges.push_back(e);
+      ranges[e].column1 = ranges[e].column0 - 1; // Mark as not gridded
+      continue;
+    }
+    for (int row = r.row0; row <= r.row1; ++row) {
+      for (int column = r.column0; column <= r.column1; ++column) {
+        ++m_edgeCellStart[static_cast<std::size_t>(row) * m_columns + column +
+                          1];
+      }
+    }
+  }
+  for (std::size_t c = 0; c < cellCount; ++c) {
+    m_edgeCellStart[c + 1] += m_edgeCellStart[c];
+  }
+  m_edgeItems.resize(m_edgeCellStart.back());
+  cursor.assign(m_edgeCellStart.begin(), m_edgeCellStart.end() - 1);
+  for (std::uint32_t e = 0; e < m_edges.size(); ++e) {
+    const CellRange &r = ranges[e];
+    for (int row = r.row0; row <= r.row1; ++row) {
+      for (int column = r.column0; column <= r.column1; ++column) {
+        m_edgeItems[cursor[static_cast<std::size_t>(row) * m_columns +
+                           column]++] = e;
+      }
+    }
+  }
+
+  m_edgeStamps.assign(m_edges.size(), 0);
+  m_stamp = 0;
+}
+
+void SpatialIndex::query(const sf::FloatRect &area, std::vector<int> &nodes,
+                         std::vector<std::pair<int, int>> &edges) const {
+  queryNodes(area, nodes);
+  queryEdges(area, edges);
+}
+
+void SpatialIndex::queryNodes(const sf::FloatRect &area,
+                              std::vector<int> &nodes) const {
+  sampleNodes(area, 1, nodes);
+}
+
+std::size_t SpatialIndex::countNodes(const sf::FloatRect &area) const {
+  CellRange r;
+  if (!nodeCells(area, r))
+    return 0;
+
+  std::size_t count = 0;
+  for (int row = r.row0; row <= r.row1; ++row) {
+    std::size_t first = static_cast<std::size_t>(row) * m_columns;
+    count += m_nodeCellStart[first + r.column1 + 1] -
+             m_nodeCellStart[first + r.column0];
+  }
+  return count;
+}
+
+void SpatialIndex::sampleNodes(const sf::FloatRect &area, std::size_t stride,
+                               std::vector<int> &nodes) const {
+  nodes.clear();
+  CellRange r;
+  if (!nodeCells(area, r))
+    return;
+
+  // A row's covered cells are contiguous in m_nodeItems, so the next
+  // sample is found by index arithmetic; `skip` carries over between rows
+  std::size_t skip = 0;
+  for (int row = r.row0; row <= r.row1; ++row) {
+    std::size_t first = static_cast<std::size_t>(row) * m_columns;
+    std::uint32_t begin = m_nodeCellStart[first + r.column0];
+    std::uint32_t end = m_nodeCellStart[first + r.column1 + 1];
+    std::size_t i = begin + skip;
+    for (; i < end; i += stride) {
+      nodes.push_back(m_nodeItems[i]);
+    }
+    skip = i - end;
+  }
+}
+
+bool SpatialIndex::nodeCells(const sf::FloatRect &area,
+                             CellRange &range) const {
+  if (m_columns == 0)
+    return false;
+
+  // Nodes are bucketed by centre, so widen the area by the drawn radius
+  // and by how far centres may have moved since they were bucketed
+  const sf::FloatRect padded =
+      grow(area, NODE_CONFIG::BASE_RADIUS +
+                     NODE_CONFIG::SELECTED_OUTLINE_THICKNESS + m_drift);
+
+  // Cell lookups clamp to the border, so reject areas off the grid first
+  const sf::FloatRect grid(m_origin, {m_columns * m_cellSize,
+                                      m_rows * m_cellSize});
+  if (!intersects(padded, grid))
+    return false;
+
+  range = cellsCovering(padded);
+  return true;
+}
+
+void SpatialIndex::queryEdges(const sf::FloatRect &area,
+                              std::vector<std::pair<int, int>> &edges) const {
+  edges.clear();
+  if (m_columns == 0)
+    return;
+
+  // Boxes were taken at build time; both endpoints may have drifted since
+  const sf::FloatRect padded = grow(area, m_drift);
+  if (++m_stamp == 0) {
+    std::fill(m_edgeStamps.begin(), m_edgeStamps.end(), 0);
+    m_stamp = 1;
+  }
+  auto consider = [&](std::uint32_t e) {
+    if (m_edgeStamps[e] == m_stamp)
+      return;
+    m_edgeStamps[e] = m_stamp;
+    if (intersects(m_edgeBounds[e], padded))
+      edges.push_back(m_edges[e]);
+  };
+
+  const CellRange r = cellsCovering(padded);
+  for (int row = r.row0; row <= r.row1; ++row) {
+    for (int column = r.column0; column <= r.column1; ++column) {
+      std::size_t cell = static_cast<std::size_t>(row) * m_columns + column;
+      for (std::uint32_t i = m_edgeCellStart[cell];
+           i < m_edgeCellStart[cell + 1]; ++i) {
+        consider(m_edgeItems[i]);
+      }
+    }
+  }
+  for (std::uint32_t e : m_longEdges) {
+    consider(e);
+  }
+}
+
+bool SpatialIndex::isStale() const {
+  return m_drift > m_cellSize * GRAPH_CONFIG::SPATIAL_MAX_DRIFT_CELLS;
+}
+
+SpatialIndex::CellRange
+SpatialIndex::cellsCovering(const sf::FloatRect &area) const {
+  auto column = [this](float x) {
+    return std::clamp(static_cast<int>(std::floor((x - m_origin.x) /
+                                                  m_cellSize)),
+                      0, m_columns - 1);
+  };
+  auto row = [this](float y) {
+    return std::clamp(static_cast<int>(std::floor((y - m_origin.y) /
+                                                  m_cellSize)),
+                      0, m_rows - 1);
+  };
+  return {column(area.position.x), row(area.position.y),
+          column(area.position.x + area.size.x),
+          row(area.position.y + area.size.y)};
+}
+
+bool SpatialIndex::intersects(const sf::FloatRect &a, const sf::FloatRect &b) {
+  return a.position.x <= b.position.x + b.size.x &&
+         b.position.x <= a.position.x + a.size.x &&
+         a.position.y <= b.position.y + b.size.y &&
+         b.position.y <= a.position.y + a.size.y;
+}
+
+sf::FloatRect SpatialIndex::grow(const sf::FloatRect &area, float pad) {
+  return {area.position - sf::Vector2f(pad, pad),
+          area.size + sf::Vector2f(2 * pad, 2 * pad)};
+}
@@ -0,0 +1,80 @@
+#include "TileCache.h"
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+TileCache::TileCache(std::size_t tileBytes, std::uint64_t dataOffset,
+                     std::size_t capacity)
+    : m_tileBytes(tileBytes), m_dataOffset(dataOffset),
+      m_capacity(capacity > 0 ? capacity : 1) {}
+
+TileCache::~TileCache() { close(); }
+
+bool TileCache::open(const std::string &path, bool writable) {
+  close();
+  if (!isPageAligned(m_tileBytes) || !isPageAligned(m_dataOffset)) {
+    std::cerr << path << ": tiles of " << m_tileBytes << " bytes at offset "
+              << m_dataOffset << " can't be mapped with this system's "
+              << getPageSize() << "-byte pages\n";
+    return false;
+  }
+  m_fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+  if (m_fd == -1) {
+    std::cerr << "Could not open " << path << "\n";
+    return false;
+  }
+  m_writable = writable;
+  return true;
+}
+
+std::size_t TileCache::getPageSize() {
+  static const std::size_t pageSize =
+      static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return pageSize;
+}
+
+void TileCache::close() {
+  while (!m_lru.empty()) {
+    evictOldest();
+  }
+  if (m_fd != -1) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+std::uint8_t *TileCache::acquire(std::uint64_t index) {
+  auto found = m_entries.find(index);
+  if (found != m_entries.end()) {
+    ++m_hits;
+    m_lru.splice(m_lru.begin(), m_lru, found->second);
+    return found->second->data;
+  }
+
+  if (m_entries.size() >= m_capacity) {
+    evictOldest();
+  }
+  const int protection = m_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+  void *data =
+      mmap(nullptr, m_tileBytes, protection, MAP_SHARED, m_fd,
+           static_cast<off_t>(m_dataOffset + index * m_tileBytes));
+  if (data == MAP_FAILED) {
+    std::cerr << "Could not map tile " << index << "\n";
+    return nullptr;
+  }
+  // Tiles are scanned front to back, so let the kernel read ahead
+  madvise(data, m_tileBytes, MADV_SEQUENTIAL);
+
+  ++m_loads;
+  m_lru.push_front({index, static_cast<std::uint8_t *>(data)});
+  m_entries[index] = m_lru.begin();
+  return m_lru.front().data;
+}
+
+void TileCache::evictOldest() {
+  const Entry &oldest = m_lru.back();
+  munmap(oldest.data, m_tileBytes);
+  m_entries.erase(oldest.index);
+  m_lru.pop_back();
+}
@@ -0,0 +1,276 @@
+#include "TiledMaze.h"
+#include "Philox.h"
+#include "TileCache.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <vector>
+
+namespace {
+constexpr std::array<char, 8> MAGIC = {'B', 'F', 'S', 'M', 'A', 'Z', 'E', 0};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint64_t DATA_OFFSET = 4096; // Header page
+constexpr std::uint32_t TILE_SIDE_GRANULE = 256; // 8 KiB tiles at minimum
+
+struct FileHeader {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t tileSide;
+  std::uint64_t width;
+  std::uint64_t height;
+  std::uint64_t dataOffset;
+  std::uint64_t tileBytes;
+  std::uint8_t reserved[16];
+};
+static_assert(sizeof(FileHeader) == 64);
+
+// The layout assumes 4 KiB pages: the header page and tiles from 8 KiB up.
+// On a 16 or 64 KiB page kernel they can't be mapped one tile at a time.
+bool fitsPageSize(std::uint64_t dataOffset, std::uint64_t tileBytes) {
+  if (TileCache::isPageAligned(dataOffset) &&
+      TileCache::isPageAligned(tileBytes))
+    return true;
+  std::cerr << "Maze files are laid out for " << DATA_OFFSET
+            << "-byte pages (header at " << dataOffset << ", tiles of "
+            << tileBytes << " bytes); this system uses "
+            << TileCache::getPageSize() << "-byte pages\n";
+  return false;
+}
+
+// One tile of the maze. Rooms sit on even local (x, y); the cells between
+// two rooms are passages and the odd/odd cells are always wall. The rooms
+// of a tile form one perfect maze (randomised depth-first search), so every
+// tile is connected on its own, and the tile opens one random passage into
+// its right and lower neighbours, which connects the whole grid of tiles.
+// A further LOOP_PERCENT of the remaining passages are knocked out.
+class TileBuilder {
+public:
+  TileBuilder(std::uint32_t side, std::vector<std::uint8_t> &tile)
+      : m_side(side), m_tile(tile) {}
+
+  // spanX x spanY is the part of the tile inside the maze
+  void build(Philox4x32 &rng, std::uint64_t spanX, std::uint64_t spanY,
+             bool linkRight, bool linkDown) {
+    m_roomsX = static_cast<std::uint32_t>((spanX + 1) / 2);
+    m_roomsY = static_cast<std::uint32_t>((spanY + 1) / 2);
+    std::fill(m_tile.begin(), m_tile.end(), 0);
+    for (std::uint32_t y = 0; y < m_roomsY; ++y)
+      for (std::uint32_t x = 0; x < m_roomsX; ++x)
+        open(2 * x, 2 * y);
+    carve(rng);
+
+    // Passages out of the tile sit in its last column / row
+    if (linkRight)
+      open(m_side - 1, 2 * randomBelow(rng, m_roomsY));
+    if (linkDown)
+      open(2 * randomBelow(rng, m_roomsX), m_side - 1);
+
+    const std::uint32_t lastX = linkRight ? m_roomsX : m_roomsX - 1;
+    const std::uint32_t lastY = linkDown ? m_roomsY : m_roomsY - 1;
+    for (std::uint32_t y = 0; y < m_roomsY; ++y) {
+      for (std::uint32_t x = 0; x < m_roomsX; ++x) {
+        if (x < lastX && isLoop(rng))
+          open(2 * x + 1, 2 * y);
+        if (y < lastY && isLoop(rng))
+          open(2 * x, 2 * y + 1);
+      }
+    }
+  }
+
+private:
+  std::uint32_t m_side;
+  std::vector<std::uint8_t> &m_tile;
+  std::uint32_t m_roomsX = 0;
+  std::uint32_t m_roomsY = 0;
+  std::vector<std::uint8_t> m_reached;
+  std::vector<std::uint32_t> m_stack;
+
+  void open(std::uint32_t x, std::uint32_t y) {
+    TiledMaze::setCell(m_tile.data(), y * m_side + x);
+  }
+
+  static std::uint32_t randomBelow(Philox4x32 &rng, std::uint32_t bound) {
+    return static_cast<std::uint32_t>(
+        (static_cast<std::uint64_t>(rng()) * bound) >> 32);
+  }
+
+  static bool isLoop(Philox4x32 &rng) {
+    return randomBelow(rng, 100) <
+           static_cast<std::uint32_t>(MAZE_CONFIG::LOOP_PERCENT);
+  }
+
+  // Iterative backtracker over the rooms, opening the passage to each
+  // newly reached room
+  void carve(Philox4x32 &rng) {
+    m_reached.assign(std::size_t{m_roomsX} * m_roomsY, 0);
+    m_stack.clear();
+    m_stack.push_back(0);
+    m_reached[0] = 1;
+    while (!m_stack.empty()) {
+      const std::uint32_t room = m_stack.back();
+      const std::uint32_t x = room % m_roomsX;
+      const std::uint32_t y = room / m_roomsX;
+      std::array<std::uint32_t, 4> candidates;
+      std::uint32_t count = 0;
+      if (y > 0 && !m_reached[room - m_roomsX])
+        candidates[count++] = room - m_roomsX;
+      if (x > 0 && !m_reached[room - 1])
+        candidates[count++] = room - 1;
+      if (x + 1 < m_roomsX && !m_reached[room + 1])
+        candidates[count++] = room + 1;
+      if (y + 1 < m_roomsY && !m_reached[room + m_roomsX])
+        candidates[count++] = room + m_roomsX;
+      if (count == 0) {
+        m_stack.pop_back();
+        continue;
+      }
+
+      const std::uint32_t next = candidates[randomBelow(rng, count)];
+      const std::uint32_t nextX = next % m_roomsX;
+      const std::uint32_t nextY = next / m_roomsX;
+      open(x + nextX, y + nextY); // Midpoint of the two rooms, doubled
+      m_reached[next] = 1;
+      m_stack.push_back(next);
+    }
+  }
+};
+} // namespace
+
+bool TiledMaze::generate(const std::string &path, std::uint64_t width,
+                         std::uint64_t height, std::uint64_t seed,
+                         std::uint32_t tileSide) {
+  if (width == 0 || height == 0 || width > MAZE_CONFIG::MAX_SIDE ||
+      height > MAZE_CONFIG::MAX_SIDE || tileSide == 0 ||
+      tileSide % TILE_SIDE_GRANULE != 0 ||
+      tileSide > MAZE_CONFIG::MAX_TILE_SIDE) {
+    std::cerr << "Maze needs sides from 1 to " << MAZE_CONFIG::MAX_SIDE
+              << " and a tile side that is a multiple of "
+              << TILE_SIDE_GRANULE << " up to " << MAZE_CONFIG::MAX_TILE_SIDE
+              << "\n";
+    return false;
+  }
+
+  const std::uint64_t tilesAcross = (width + tileSide - 1) / tileSide;
+  const std::uint64_t tilesDown = (height + tileSide - 1) / tileSide;
+  const std::uint64_t tileBytes = std::uint64_t{tileSide} * tileSide / 8;
+  if (!fitsPageSize(DATA_OFFSET, tileBytes))
+    return false;
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    std::cerr << "Could not write maze: " << path << "\n";
+    return false;
+  }
+
+  FileHeader header{};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.tileSide = tileSide;
+  header.width = width;
+  header.height = height;
+  header.dataOffset = DATA_OFFSET;
+  header.tileBytes = tileBytes;
+  std::vector<char> page(DATA_OFFSET, 0);
+  std::memcpy(page.data(), &header, sizeof(header));
+  out.write(page.data(), static_cast<std::streamsize>(page.size()));
+
+  std::cout << "Generating " << width << " x " << height << " maze in "
+            << tilesAcross * tilesDown << " tiles of " << tileSide << " x "
+            << tileSide << " (" << tileBytes / 1024 << " KiB each)\n";
+
+  auto startTime = std::chrono::steady_clock::now();
+  auto lastReport = startTime;
+  std::vector<std::uint8_t> tile(tileBytes);
+  TileBuilder builder(tileSide, tile);
+  for (std::uint64_t tileY = 0; tileY < tilesDown; ++tileY) {
+    for (std::uint64_t tileX = 0; tileX < tilesAcross; ++tileX) {
+      const std::uint64_t spanX =
+          std::min<std::uint64_t>(tileSide, width - tileX * tileSide);
+      const std::uint64_t spanY =
+          std::min<std::uint64_t>(tileSide, height - tileY * tileSide);
+      Philox4x32 rng(seed, tileY * tilesAcross + tileX);
+      builder.build(rng, spanX, spanY, tileX + 1 < tilesAcross,
+                    tileY + 1 < tilesDown);
+      out.write(reinterpret_cast<const char *>(tile.data()),
+                static_cast<std::streamsize>(tile.size()));
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<float>(now - lastReport).count() >=
+        MAZE_CONFIG::REPORT_SECONDS) {
+      lastReport = now;
+      std::cout << "  " << (tileY + 1) * tilesAcross << " / "
+                << tilesAcross * tilesDown << " tiles\n";
+    }
+  }
+
+  out.close();
+  if (!out) {
+    std::cerr << "Could not write maze: " << path << "\n";
+    return false;
+  }
+  const float seconds = std::chrono::duration<float>(
+                            std::chrono::steady_clock::now() - startTime)
+                            .count();
+  const std::uint64_t fileBytes =
+      DATA_OFFSET + tilesAcross * tilesDown * tileBytes;
+  std::cout << "Wrote " << path << " (" << (fileBytes >> 20) << " MiB) in "
+            << seconds << " s\n";
+  return true;
+}
+
+bool TiledMaze::open(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  FileHeader header{};
+  if (!in || !in.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    std::cerr << "Could not read maze: " << path << "\n";
+    return false;
+  }
+
+  bool valid = header.magic == MAGIC && header.version == VERSION &&
+               header.width > 0 && header.height > 0 &&
+               header.width <= MAZE_CONFIG::MAX_SIDE &&
+               header.height <= MAZE_CONFIG::MAX_SIDE &&
+               header.tileSide > 0 &&
+               header.tileSide % TILE_SIDE_GRANULE == 0 &&
+               header.tileSide <= MAZE_CONFIG::MAX_TILE_SIDE &&
+               header.tileBytes ==
+                   std::uint64_t{header.tileSide} * header.tileSide / 8 &&
+               header.dataOffset % DATA_OFFSET == 0;
+  if (!valid) {
+    std::cerr << path << ": not a maze of this version\n";
+    return false;
+  }
+  if (!fitsPageSize(header.dataOffset, header.tileBytes))
+    return false;
+
+  const std::uint64_t tilesAcross =
+      (header.width + header.tileSide - 1) / header.tileSide;
+  const std::uint64_t tilesDown =
+      (header.height + header.tileSide - 1) / header.tileSide;
+  // The bounded sides keep the tile bytes under 2^60; the offset is only
+  // ever subtracted so a huge one can't wrap past the file size
+  const std::uint64_t dataBytes = tilesAcross * tilesDown * header.tileBytes;
+  struct stat info;
+  if (stat(path.c_str(), &info) == -1 ||
+      static_cast<std::uint64_t>(info.st_size) < dataBytes ||
+      static_cast<std::uint64_t>(info.st_size) - dataBytes <
+          header.dataOffset) {
+    std::cerr << path << ": truncated maze\n";
+    return false;
+  }
+
+  m_path = path;
+  m_width = header.width;
+  m_height = header.height;
+  m_tileSide = header.tileSide;
+  m_tilesAcross = tilesAcross;
+  m_tilesDown = tilesDown;
+  m_tileBytes = header.tileBytes;
+  m_dataOffset = header.dataOffset;
+  return true;
+}
@@ -0,0 +1,287 @@
+#include "TiledMazeSolver.h"
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+TiledMazeSolver::TiledMazeSolver(const TiledMaze &maze)
+    : m_maze(maze),
+      m_walls(maze.getTileBytes(), maze.getDataOffset(),
+              MAZE_CONFIG::CACHE_TILES),
+      m_visited(maze.getTileBytes(), 0, MAZE_CONFIG::CACHE_TILES),
+      m_scratchDir(maze.getPath() + ".scratch") {}
+
+TiledMazeSolver::~TiledMazeSolver() {
+  m_visited.close();
+  removeScratch();
+}
+
+bool TiledMazeSolver::createScratch() {
+  removeScratch();
+  std::error_code error;
+  std::filesystem::create_directories(m_scratchDir, error);
+  if (error) {
+    std::cerr << "Could not create " << m_scratchDir << "\n";
+    return false;
+  }
+
+  // Sparse until the traversal touches it: reads of untouched tiles are
+  // zero pages and cost no disk
+  const std::string visitedPath = m_scratchDir + "/visited.bits";
+  int fd = ::open(visitedPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1 ||
+      ftruncate(fd, static_cast<off_t>(m_maze.getTileCount() *
+                                       m_maze.getTileBytes())) == -1) {
+    std::cerr << "Could not create " << visitedPath << "\n";
+    if (fd != -1)
+      ::close(fd);
+    return false;
+  }
+  ::close(fd);
+  return m_visited.open(visitedPath, true);
+}
+
+void TiledMazeSolver::removeScratch() {
+  std::error_code error;
+  std::filesystem::remove_all(m_scratchDir, error);
+}
+
+bool TiledMazeSolver::locate(std::uint64_t x, std::uint64_t y,
+                             std::uint64_t &tile,
+                             std::uint32_t &local) const {
+  if (x >= m_maze.getWidth() || y >= m_maze.getHeight())
+    return false;
+  const std::uint32_t side = m_maze.getTileSide();
+  tile = (y / side) * m_maze.getTilesAcross() + x / side;
+  local = static_cast<std::uint32_t>((y % side) * side + x % side);
+  return true;
+}
+
+bool TiledMazeSolver::solve(std::uint64_t sourceX, std::uint64_t sourceY,
+                            std::uint64_t targetX, std::uint64_t targetY,
+                            MazeSolveResult &result) {
+  result = {};
+  std::uint64_t sourceTile = 0;
+  std::uint32_t sourceLocal = 0;
+  if (!locate(sourceX, sourceY, sourceTile, sourceLocal) ||
+      !locate(targetX, targetY, m_targetTile, m_targetLocal)) {
+    std::cerr << "Source or target is outside the maze\n";
+    return false;
+  }
+  if (!m_walls.open(m_maze.getPath(), false) || !createScratch())
+    return false;
+
+  // An acquired tile may be unmapped by the next acquire (the cache can be
+  // one tile), so each cell is tested right after its own acquire
+  const std::uint8_t *walls = m_walls.acquire(sourceTile);
+  bool isOpen = walls && TiledMaze::testCell(walls, sourceLocal);
+  walls = isOpen ? m_walls.acquire(m_targetTile) : nullptr;
+  isOpen = walls && TiledMaze::testCell(walls, m_targetLocal);
+  if (!isOpen) {
+    std::cerr << "Source or target is a wall\n";
+    return false;
+  }
+
+  std::cout << "Solving " << m_maze.getWidth() << " x "
+            << m_maze.getHeight() << " maze from (" << sourceX << ", "
+            << sourceY << ") to (" << targetX << ", " << targetY << ")\n";
+
+  auto startTime = std::chrono::steady_clock::now();
+  auto lastReport = startTime;
+  m_next.clear();
+  m_next[sourceTile].incoming.push_back(sourceLocal);
+  bool ok = true;
+  std::uint64_t level = 0;
+  for (; ok && !result.reached && !m_next.empty(); ++level) {
+    m_current.swap(m_next);
+    m_next.clear();
+    m_buffered = 0;
+
+    std::uint64_t frontier = 0;
+    for (const auto &[tile, bucket] : m_current)
+      frontier += bucket.admitted.size() + bucket.incoming.size();
+    result.peakFrontier = std::max(result.peakFrontier, frontier);
+
+    for (auto &[tile, bucket] : m_current) {
+      ok = expandTile(tile, bucket, level, result);
+      if (!ok || result.reached)
+        break;
+      if (m_buffered > MAZE_CONFIG::FRONTIER_BUDGET_ENTRIES)
+        ok = spillIncoming(level + 1, result);
+    }
+    m_current.clear();
+
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<float>(now - lastReport).count() >=
+        MAZE_CONFIG::REPORT_SECONDS) {
+      lastReport = now;
+      std::cout << "  level " << level << ": " << result.visited
+                << " cells settled, " << m_next.size()
+                << " tiles in the frontier\n";
+    }
+  }
+  result.levels = level;
+  m_next.clear();
+
+  const float seconds = std::chrono::duration<float>(
+                            std::chrono::steady_clock::now() - startTime)
+                            .count();
+  const std::size_t loads = getTileLoads();
+  m_walls.close();
+  m_visited.close();
+  removeScratch();
+  if (!ok)
+    return false;
+
+  if (result.reached)
+    std::cout << "Distance " << result.distance << "\n";
+  else
+    std::cout << "Target unreachable\n";
+  std::cout << result.visited << " cells settled over " << result.levels
+            << " levels in " << seconds << " s\n"
+            << result.tileVisits << " tile visits, " << loads
+            << " tile maps (maze + visited), " << result.spilled
+            << " frontier entries spilled, peak frontier "
+            << result.peakFrontier << "\n";
+  return true;
+}
+
+bool TiledMazeSolver::expandTile(std::uint64_t tile, Bucket &bucket,
+                                 std::uint64_t level,
+                                 MazeSolveResult &result) {
+  if (bucket.spilled && !readSpill(tile, level, bucket.incoming))
+    return false;
+  const std::uint8_t *walls = m_walls.acquire(tile);
+  std::uint8_t *visited = m_visited.acquire(tile);
+  if (!walls || !visited)
+    return false;
+  ++result.tileVisits;
+
+  for (std::uint32_t local : bucket.incoming) {
+    if (!TiledMaze::testCell(walls, local) ||
+        TiledMaze::testCell(visited, local))
+      continue;
+    TiledMaze::setCell(visited, local);
+    ++result.visited;
+    if (tile == m_targetTile && local == m_targetLocal) {
+      result.reached = true;
+      result.distance = level;
+      return true;
+    }
+    bucket.admitted.push_back(local);
+  }
+
+  // std::map nodes don't move, so the pointer survives other insertions
+  std::vector<std::uint32_t> *nextAdmitted = nullptr;
+  auto settle = [&](std::uint32_t neighbor) {
+    if (!TiledMaze::testCell(walls, neighbor) ||
+        TiledMaze::testCell(visited, neighbor))
+      return false;
+    TiledMaze::setCell(visited, neighbor);
+    ++result.visited;
+    if (tile == m_targetTile && neighbor == m_targetLocal) {
+      result.reached = true;
+      result.distance = level + 1;
+      return true;
+    }
+    if (!nextAdmitted)
+      nextAdmitted = &m_next[tile].admitted;
+    nextAdmitted->push_back(neighbor);
+    return false;
+  };
+  auto pass = [this](std::uint64_t neighborTile, std::uint32_t neighbor) {
+    m_next[neighborTile].incoming.push_back(neighbor);
+    ++m_buffered;
+  };
+
+  const std::uint32_t side = m_maze.getTileSide();
+  const std::uint32_t lastRow = (side - 1) * side;
+  const std::uint64_t across = m_maze.getTilesAcross();
+  const std::uint64_t tileX = tile % across;
+  const std::uint64_t tileY = tile / across;
+  for (std::uint32_t local : bucket.admitted) {
+    const std::uint32_t localY = local / side;
+    const std::uint32_t localX = local - localY * side;
+    if (localY > 0) {
+      if (settle(local - side))
+        return true;
+    } else if (tileY > 0) {
+      pass(tile - across, local + lastRow);
+    }
+    if (localX > 0) {
+      if (settle(local - 1))
+        return true;
+    } else if (tileX > 0) {
+      pass(tile - 1, local + side - 1);
+    }
+    if (localX + 1 < side) {
+      if (settle(local + 1))
+        return true;
+    } else if (tileX + 1 < across) {
+      pass(tile + 1, local - (side - 1));
+    }
+    if (localY + 1 < side) {
+      if (settle(local + side))
+        return true;
+    } else if (tileY + 1 < m_maze.getTilesDown()) {
+      pass(tile + across, local - lastRow);
+    }
+  }
+  return true;
+}
+
+bool TiledMazeSolver::spillIncoming(std::uint64_t level,
+                                    MazeSolveResult &result) {
+  for (auto &[tile, bucket] : m_next) {
+    if (bucket.incoming.empty())
+      continue;
+    std::ofstream out(getSpillPath(tile, level),
+                      std::ios::binary | std::ios::app);
+    out.write(reinterpret_cast<const char *>(bucket.incoming.data()),
+              static_cast<std::streamsize>(bucket.incoming.size() *
+                                           sizeof(std::uint32_t)));
+    if (!out) {
+      std::cerr << "Could not spill frontier to "
+                << getSpillPath(tile, level) << "\n";
+      return false;
+    }
+    result.spilled += bucket.incoming.size();
+    bucket.incoming.clear();
+    bucket.incoming.shrink_to_fit();
+    bucket.spilled = true;
+  }
+  m_buffered = 0;
+  return true;
+}
+
+bool TiledMazeSolver::readSpill(std::uint64_t tile, std::uint64_t level,
+                                std::vector<std::uint32_t> &out) {
+  const std::string path = getSpillPath(tile, level);
+  std::error_code error;
+  const auto bytes = std::filesystem::file_size(path, error);
+  std::ifstream in(path, std::ios::binary);
+  if (error || !in) {
+    std::cerr << "Could not read spilled frontier " << path << "\n";
+    return false;
+  }
+  const std::size_t start = out.size();
+  out.resize(start + bytes / sizeof(std::uint32_t));
+  in.read(reinterpret_cast<char *>(out.data() + start),
+          static_cast<std::streamsize>(bytes));
+  if (!in) {
+    std::cerr << "Could not read spilled frontier " << path << "\n";
+    return false;
+  }
+  in.close();
+  std::filesystem::remove(path, error);
+  return true;
+}
+
+std::string TiledMazeSolver::getSpillPath(std::uint64_t tile,
+                                          std::uint64_t level) const {
+  return m_scratchDir + "/tile_" + std::to_string(tile) + "_level_" +
+         std::to_string(level) + ".spill";
+}
@@ -0,0 +1,422 @@
+#include "TraversalBenchmark.h"
+#include "BFSVisualizer.h"
+#include "CompressedAdjacency.h"
+#include "Config.h"
+#include "DynamicBFS.h"
+#include "CsrGraph.h"
+#include "ErasedGraph.h"
+#include "FramePool.h"
+#include "Graph.h"
+#include "GridGraph.h"
+#include "RingBuffer.h"
+#include "TraversalEngine.h"
+#include "TraversalKernels.h"
+#include "TraversalStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+struct RunResult {
+  std::size_t steps = 0;
+  double seconds = 0.0;
+};
+
+CompressedAdjacency buildGrid(int side) {
+  std::vector<std::vector<int>> neighborLists(side * side);
+  for (int row = 0; row < side; ++row) {
+    for (int col = 0; col < side; ++col) {
+      auto &list = neighborLists[row * side + col];
+      if (row > 0)
+        list.push_back((row - 1) * side + col);
+      if (col > 0)
+        list.push_back(row * side + col - 1);
+      if (col + 1 < side)
+        list.push_back(row * side + col + 1);
+      if (row + 1 < side)
+        list.push_back((row + 1) * side + col);
+    }
+  }
+  return CompressedAdjacency(std::move(neighborLists));
+}
+
+// The same 4-connected grid as a drawable Graph, row-major ids
+void buildGridGraph(Graph &graph, int side) {
+  const float spacing = GRAPH_CONFIG::MIN_NODE_DISTANCE;
+  for (int row = 0; row < side; ++row) {
+    for (int col = 0; col < side; ++col) {
+      graph.addNode(row * side + col, {col * spacing, row * spacing});
+    }
+  }
+  for (int row = 0; row < side; ++row) {
+    for (int col = 0; col < side; ++col) {
+      int vertex = row * side + col;
+      if (col + 1 < side)
+        graph.addEdge(vertex, vertex + 1);
+      if (row + 1 < side)
+        graph.addEdge(vertex, vertex + side);
+    }
+  }
+}
+
+// BFSVisualizer as it was before the traversal engine: hash-set visited
+// tracking, a level vector, node states buffered in a hash map, and two
+// clock reads around every expansion. Kept verbatim so run() compares the
+// engine-driven step() against the path it replaced, not a tuned rewrite.
+class LegacyVisualizer {
+public:
+  explicit LegacyVisualizer(Graph &graph)
+      : m_graph(graph), m_distances(graph) {}
+
+  void startBFS(int startNodeId) {
+    m_currentNode = -1;
+    m_queue.clear();
+    m_visited.clear();
+    m_visitOrder.clear();
+    m_levels.clear();
+    m_distances.clear();
+    m_stats.clear();
+    m_pendingStates.clear();
+    for (const auto &[id, node] : m_graph.getNodes())
+      node->setState(NodeState::UNVISITED);
+
+    m_adjacency = CompressedAdjacency(m_graph);
+    m_distances.setSource(startNodeId);
+    m_running = true;
+    m_queue.reserve(m_graph.getNodes().size());
+    m_queue.push_back(startNodeId);
+    m_visited.insert(startNodeId);
+    m_levels.assign(m_adjacency.getVertexCount(), -1);
+    m_levels[startNodeId] = 0;
+    m_visitOrder.push_back(startNodeId);
+    m_pendingStates[startNodeId] = NodeState::IN_QUEUE;
+  }
+
+  void step() {
+    if (!m_running)
+      return;
+    if (m_queue.empty()) {
+      finish();
+      return;
+    }
+    if (m_currentNode != -1)
+      m_pendingStates[m_currentNode] = NodeState::VISITED;
+
+    m_currentNode = m_queue.front();
+    m_queue.pop_front();
+    m_pendingStates[m_currentNode] = NodeState::CURRENT;
+
+    const auto expandStart = std::chrono::steady_clock::now();
+    const int level = m_levels[m_currentNode];
+    size_t edgesExamined = 0;
+    size_t discovered = 0;
+    for (int neighborId : m_adjacency.neighbors(m_currentNode)) {
+      ++edgesExamined;
+      if (m_visited.find(neighborId) == m_visited.end()) {
+        m_visited.insert(neighborId);
+        m_queue.push_back(neighborId);
+        m_visitOrder.push_back(neighborId);
+        m_levels[neighborId] = level + 1;
+        m_pendingStates[neighborId] = NodeState::IN_QUEUE;
+        ++discovered;
+      }
+    }
+    m_stats.recordExpansion(level, edgesExamined, discovered);
+    m_stats.addElapsed(std::chrono::duration<double, std::micro>(
+                           std::chrono::steady_clock::now() - expandStart)
+                           .count());
+
+    if (m_queue.empty())
+      finish();
+  }
+
+  void flushNodeStates() {
+    for (const auto &[nodeId, state] : m_pendingStates) {
+      if (auto node = m_graph.getNode(nodeId))
+        node->setState(state);
+    }
+    m_pendingStates.clear();
+  }
+
+  bool isRunning() const { return m_running; }
+  const std::vector<int> &getVisitOrder() const { return m_visitOrder; }
+  const TraversalStats &getStats() const { return m_stats; }
+
+private:
+  Graph &m_graph;
+  CompressedAdjacency m_adjacency;
+  DynamicBFS m_distances;
+  RingBuffer<int> m_queue;
+  std::unordered_set<int> m_visited;
+  std::vector<int> m_levels;
+  std::vector<int> m_visitOrder;
+  std::unordered_map<int, NodeState> m_pendingStates;
+  TraversalStats m_stats;
+  int m_currentNode = -1;
+  bool m_running = false;
+
+  void finish() {
+    m_running = false;
+    if (m_currentNode != -1)
+      m_pendingStates[m_currentNode] = NodeState::VISITED;
+    m_currentNode = -1;
+  }
+};
+
+// One full traversal from node 0, node states applied at the end as a
+// frame's update() would
+RunResult runLegacy(LegacyVisualizer &visualizer) {
+  RunResult result;
+  auto start = std::chrono::steady_clock::now();
+  visualizer.startBFS(0);
+  while (visualizer.isRunning()) {
+    visualizer.step();
+    ++result.steps;
+  }
+  visualizer.flushNodeStates();
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return result;
+}
+
+RunResult runCurrent(BFSVisualizer &visualizer) {
+  RunResult result;
+  auto start = std::chrono::steady_clock::now();
+  visualizer.startBFS(0);
+  while (visualizer.getState() == BFSState::RUNNING) {
+    visualizer.step();
+    ++result.steps;
+  }
+  visualizer.update(0.0f);
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return result;
+}
+
+bool sameLevels(const TraversalStats &a, const TraversalStats &b) {
+  const auto &x = a.getLevels();
+  const auto &y = b.getLevels();
+  if (x.size() != y.size())
+    return false;
+  for (size_t i = 0; i < x.size(); ++i) {
+    if (x[i].frontierSize != y[i].frontierSize ||
+        x[i].edgesExamined != y[i].edgesExamined ||
+        x[i].discovered != y[i].discovered)
+      return false;
+  }
+  return true;
+}
+
+// Best-of-N level BFS from vertex 0; fails if the levels differ from
+// `expected` (when given)
+template <TraversableGraph G>
+bool timeKernel(const char *name, const G &graph, std::size_t bytes,
+                int repeats, std::vector<std::int32_t> &levels,
+                const std::vector<std::int32_t> *expected) {
+  std::vector<typename G::VertexId> queue;
+  double best = 0.0;
+  std::size_t reached = 0;
+  for (int repeat = 0; repeat < repeats; ++repeat) {
+    auto start = std::chrono::steady_clock::now();
+    reached = TraversalKernels::breadthFirstLevels(graph, 0, levels, queue);
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    if (repeat == 0 || seconds < best)
+      best = seconds;
+  }
+  if (expected && levels != *expected) {
+    std::cerr << name << ": levels differ from the reference" << std::endl;
+    return false;
+  }
+
+  std::cout << "  " << name << ": " << best * 1e3 << " ms, "
+            << static_cast<double>(reached) / best / 1e6
+            << " M vertices/s, graph " << bytes / (1024 * 1024) << " MiB"
+            << std::endl;
+  return true;
+}
+
+// The step engine over the same backend: BFS from vertex 0 to completion,
+// pulling every event; fails if its levels differ from `expected`
+template <TraversableGraph G>
+bool timeEngine(const char *name, const G &graph, int repeats,
+                const std::vector<std::int32_t> &expected) {
+  TraversalContext context;
+  double best = 0.0;
+  std::size_t events = 0;
+  for (int repeat = 0; repeat < repeats; ++repeat) {
+    context.reset(static_cast<int>(graph.getVertexCount()));
+    events = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto engine = TraversalEngine::breadthFirst(graph, context, 0);
+    while (engine.next()) {
+      ++events;
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    if (repeat == 0 || seconds < best)
+      best = seconds;
+  }
+  if (context.level != expected) {
+    std::cerr << name << ": engine levels differ from the reference"
+              << std::endl;
+    return false;
+  }
+
+  std::cout << "  " << name << ": " << best * 1e3 << " ms, "
+            << static_cast<double>(events) / best / 1e6 << " M events/s"
+            << std::endl;
+  return true;
+}
+
+void report(const char *name, const RunResult &best) {
+  std::cout << "  " << name << ": " << best.seconds * 1e3 << " ms, "
+            << static_cast<double>(best.steps) / best.seconds / 1e6
+            << " M steps/s, "
+            << best.seconds * 1e9 / static_cast<double>(best.steps)
+            << " ns/step" << std::endl;
+}
+} // namespace
+
+TraversalBenchmark::TraversalBenchmark(TraversalBenchmarkOptions options)
+    : m_options(options) {}
+
+bool TraversalBenchmark::run() {
+  const int side = m_options.gridSide;
+  std::cout << "Building " << side << "x" << side << " graph..." << std::endl;
+  Graph graph;
+  buildGridGraph(graph, side);
+
+  // Best-of-N for each, alternating so neither gets a warmer cache. Both
+  // visualizers are reused across runs like the application's, so only
+  // the first engine run may allocate a coroutine frame.
+  LegacyVisualizer legacy(graph);
+  BFSVisualizer current(graph);
+  RunResult bestLegacy, bestCurrent;
+  std::size_t allocationsBefore = FramePool::getSystemAllocations();
+  for (int repeat = 0; repeat < m_options.repeats; ++repeat) {
+    RunResult before = runLegacy(legacy);
+    RunResult after = runCurrent(current);
+    if (before.steps != after.steps ||
+        legacy.getVisitOrder() != current.getVisitOrder() ||
+        !sameLevels(legacy.getStats(), current.getStats())) {
+      std::cerr << "Traversal mismatch between the old and new step()"
+                << std::endl;
+      return false;
+    }
+    if (repeat == 0 || before.seconds < bestLegacy.seconds)
+      bestLegacy = before;
+    if (repeat == 0 || after.seconds < bestCurrent.seconds)
+      bestCurrent = after;
+  }
+  std::size_t frameAllocations =
+      FramePool::getSystemAllocations() - allocationsBefore;
+
+  std::cout << bestLegacy.steps << " steps (startBFS included), best of "
+            << m_options.repeats << ":" << std::endl;
+  report("pre-engine step()", bestLegacy);
+  report("engine step()", bestCurrent);
+  std::cout << "  coroutine frames from the system allocator: "
+            << frameAllocations << " over " << m_options.repeats << " runs"
+            << std::endl;
+  return true;
+}
+
+bool TraversalBenchmark::runKernels() {
+  const int side = m_options.gridSide;
+  std::cout << "Building " << side << "x" << side << " grid backends..."
+            << std::endl;
+  CompressedAdjacency compressed = buildGrid(side);
+  CsrGraph<std::uint32_t> csr32(compressed);
+  CsrGraph<std::uint64_t> csr64(compressed);
+  GridGraph<std::uint32_t> grid32(side, side);
+  GridGraph<std::uint64_t> grid64(side, side);
+
+  std::cout << "Level BFS over " << compressed.getVertexCount()
+            << " vertices, best of " << m_options.repeats << ":" << std::endl;
+  std::vector<std::int32_t> reference, levels;
+  const int repeats = m_options.repeats;
+  bool ok =
+      timeKernel("compressed", compressed, compressed.getByteSize(), repeats,
+                 reference, nullptr) &&
+      timeKernel("csr 32-bit", csr32, csr32.getByteSize(), repeats, levels,
+                 &reference) &&
+      timeKernel("csr 64-bit", csr64, csr64.getByteSize(), repeats, levels,
+                 &reference) &&
+      timeKernel("grid 32-bit", grid32, 0, repeats, levels, &reference) &&
+      timeKernel("grid 64-bit", grid64, 0, repeats, levels, &reference) &&
+      timeKernel("erased compressed", ErasedGraph(compressed),
+                 compressed.getByteSize(), repeats, levels, &reference) &&
+      timeKernel("erased csr", ErasedGraph(csr32), csr32.getByteSize(),
+                 repeats, levels, &reference) &&
+      timeKernel("erased grid", ErasedGraph(grid32), 0, repeats, levels,
+                 &reference);
+  if (!ok)
+    return false;
+
+  // The visualizer's BFS engine is instantiated over the same backends
+  std::cout << "Step engine (TraversalEngine::breadthFirst), every event "
+            << "pulled:" << std::endl;
+  return timeEngine("compressed", compressed, repeats, reference) &&
+         timeEngine("csr 32-bit", csr32, repeats, reference) &&
+         timeEngine("grid 32-bit", grid32, repeats, reference);
+}
+
+bool TraversalBenchmark::runTurbo() {
+  const int side = m_options.gridSide;
+  std::cout << "Building " << side << "x" << side << " graph..." << std::endl;
+  Graph graph;
+  buildGridGraph(graph, side);
+
+  BFSVisualizer visualizer(graph);
+  visualizer.startBFS(0);
+  visualizer.setTurbo(true);
+  visualizer.setAutoStep(true);
+
+  // One update() per frame, as Application::run calls it, with a fixed
+  // 60 Hz frame time; wall time is measured around each call
+  using Clock = std::chrono::steady_clock;
+  const float frameSeconds = 1.0f / 60.0f;
+  std::size_t frames = 0;
+  double longestMillis = 0.0;
+  auto start = Clock::now();
+  while (visualizer.getState() == BFSState::RUNNING) {
+    auto frameStart = Clock::now();
+    visualizer.update(frameSeconds);
+    longestMillis = std::max(
+        longestMillis, std::chrono::duration<double, std::milli>(
+                           Clock::now() - frameStart)
+                           .count());
+    ++frames;
+  }
+  double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  const std::size_t nodes = graph.getNodes().size();
+  std::size_t visited = 0;
+  for (const auto &[id, node] : graph.getNodes()) {
+    if (node->getState() == NodeState::VISITED)
+      ++visited;
+  }
+  if (visualizer.getVisitOrder().size() != nodes || visited != nodes) {
+    std::cerr << "Turbo run visited " << visited << " of " << nodes
+              << " nodes" << std::endl;
+    return false;
+  }
+
+  std::cout << nodes << " nodes in " << frames << " frames ("
+            << ALGO_CONFIG::TURBO_FRAME_BUDGET_MS << " ms step budget), "
+            << seconds * 1e3 << " ms of update(), longest frame "
+            << longestMillis << " ms, "
+            << static_cast<double>(nodes) / seconds / 1e6 << " M steps/s"
+            << std::endl;
+  return true;
+}
@@ -0,0 +1,86 @@
+#include "TraversalEngine.h"
+
+void TraversalContext::reset(int vertexCount) {
+  level.assign(vertexCount, -1);
+  parent.assign(vertexCount, -1);
+  distance.assign(vertexCount, UNREACHED);
+  settled.assign(vertexCount, 0);
+  queue.clear();
+  queue.reserve(vertexCount);
+  heap.clear();
+  frontier = 0;
+  complete = false;
+}
+
+void TraversalContext::grow(int vertexCount) {
+  if (vertexCount > static_cast<int>(level.size())) {
+    level.resize(vertexCount, -1);
+    parent.resize(vertexCount, -1);
+    distance.resize(vertexCount, UNREACHED);
+    settled.resize(vertexCount, 0);
+  }
+}
+
+Generator<TraversalEvent>
+TraversalEngine::create(TraversalAlgorithm algorithm,
+                       const CompressedAdjacency &adjacency,
+                       TraversalContext &context, int start, int target,
+                       const std::vector<std::uint32_t> *heuristic) {
+  switch (algorithm) {
+  case TraversalAlgorithm::ZERO_ONE_BFS:
+    return zeroOneBreadthFirst(adjacency, context, start, target);
+  case TraversalAlgorithm::DIJKSTRA:
+    return bestFirst(adjacency, context, start, target);
+  case TraversalAlgorithm::A_STAR:
+    return bestFirst(adjacency, context, start, target, heuristic);
+  case TraversalAlgorithm::BFS:
+    break;
+  }
+  return breadthFirst(adjacency, context, start, target);
+}
+
+const char *TraversalEngine::getName(TraversalAlgorithm algorithm) {
+  switch (algorithm) {
+  case TraversalAlgorithm::ZERO_ONE_BFS:
+    return "0-1 BFS";
+  case TraversalAlgorithm::DIJKSTRA:
+    return "Dijkstra";
+  case TraversalAlgorithm::A_STAR:
+    return "A*";
+  case TraversalAlgorithm::BFS:
+    return "BFS";
+  }
+  return "Unknown";
+}
+
+EdgeWeights TraversalEngine::getEdgeWeights(TraversalAlgorithm algorithm) {
+  switch (algorithm) {
+  case TraversalAlgorithm::ZERO_ONE_BFS:
+    return EdgeWeights::ZERO_ONE;
+  case TraversalAlgorithm::DIJKSTRA:
+  case TraversalAlgorithm::A_STAR:
+    return EdgeWeights::LENGTH;
+  case TraversalAlgorithm::BFS:
+    break;
+  }
+  return EdgeWeights::NONE;
+}
+
+bool TraversalEngine::usesQueue(TraversalAlgorithm algorithm) {
+  return algorithm == TraversalAlgorithm::BFS ||
+         algorithm == TraversalAlgorithm::ZERO_ONE_BFS;
+}
+
+TraversalAlgorithm TraversalEngine::next(TraversalAlgorithm algorithm) {
+  switch (algorithm) {
+  case TraversalAlgorithm::BFS:
+    return TraversalAlgorithm::ZERO_ONE_BFS;
+  case TraversalAlgorithm::ZERO_ONE_BFS:
+    return TraversalAlgorithm::DIJKSTRA;
+  case TraversalAlgorithm::DIJKSTRA:
+    return TraversalAlgorithm::A_STAR;
+  case TraversalAlgorithm::A_STAR:
+    break;
+  }
+  return TraversalAlgorithm::BFS;
+}
@@ -0,0 +1,106 @@
+#include "TraversalStats.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+void TraversalStats::clear() {
+  m_levels.clear();
+  m_largestFrontier = 0;
+  m_totalExpanded = 0;
+  m_totalEdges = 0;
+  m_totalMicros = 0.0;
+  m_untimed.clear();
+  m_untimedCount = 0;
+}
+
+void TraversalStats::restore(std::vector<LevelStats> levels) {
+  clear();
+  m_levels = std::move(levels);
+  for (const auto &stats : m_levels) {
+    m_largestFrontier = std::max(m_largestFrontier, stats.frontierSize);
+    m_totalExpanded += stats.frontierSize;
+    m_totalEdges += stats.edgesExamined;
+    m_totalMicros += stats.micros;
+  }
+}
+
+void TraversalStats::recordExpansion(int level, size_t edgesExamined,
+                                     size_t discovered) {
+  if (level < 0)
+    return;
+
+  while (static_cast<int>(m_levels.size()) <= level) {
+    LevelStats next;
+    next.level = static_cast<int>(m_levels.size());
+    m_levels.push_back(next);
+  }
+
+  LevelStats &stats = m_levels[level];
+  ++stats.frontierSize;
+  stats.edgesExamined += edgesExamined;
+  stats.discovered += discovered;
+
+  m_largestFrontier = std::max(m_largestFrontier, stats.frontierSize);
+  ++m_totalExpanded;
+  m_totalEdges += edgesExamined;
+
+  if (!m_untimed.empty() && m_untimed.back().first == level) {
+    ++m_untimed.back().second;
+  } else {
+    m_untimed.emplace_back(level, 1);
+  }
+  ++m_untimedCount;
+}
+
+void TraversalStats::addElapsed(double micros) {
+  if (m_untimedCount == 0)
+    return;
+
+  const double share = micros / static_cast<double>(m_untimedCount);
+  for (const auto &[level, count] : m_untimed) {
+    m_levels[level].micros += share * static_cast<double>(count);
+  }
+  m_totalMicros += micros;
+  m_untimed.clear();
+  m_untimedCount = 0;
+}
+
+bool TraversalStats::exportCsv(const std::string &path) const {
+  std::ofstream out(path);
+  if (!out) {
+    std::cerr << "Could not write " << path << "\n";
+    return false;
+  }
+
+  out << "level,frontier_size,edges_examined,discovered,micros\n";
+  for (const auto &stats : m_levels) {
+    out << stats.level << ',' << stats.frontierSize << ','
+        << stats.edgesExamined << ',' << stats.discovered << ','
+        << stats.micros << '\n';
+  }
+  return static_cast<bool>(out);
+}
+
+bool TraversalStats::exportJson(const std::string &path) const {
+  std::ofstream out(path);
+  if (!out) {
+    std::cerr << "Could not write " << path << "\n";
+    return false;
+  }
+
+  out << "{\n"
+      << "  \"total_expanded\": " << m_totalExpanded << ",\n"
+      << "  \"total_edges_examined\": " << m_totalEdges << ",\n"
+      << "  \"total_micros\": " << m_totalMicros << ",\n"
+      << "  \"levels\": [";
+  for (size_t i = 0; i < m_levels.size(); ++i) {
+    const LevelStats &stats = m_levels[i];
+    out << (i > 0 ? "," : "") << "\n    {\"level\": " << stats.level
+        << ", \"frontier_size\": " << stats.frontierSize
+        << ", \"edges_examined\": " << stats.edgesExamined
+        << ", \"discovered\": " << stats.discovered
+        << ", \"micros\": " << stats.micros << "}";
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out);
+}